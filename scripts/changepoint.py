@@ -0,0 +1,142 @@
+import argparse
+import json
+import math
+import os
+from collections import defaultdict
+
+# Change-point detection over the per-commit data perfmetricsRun.py
+# collects, replacing manual eyeballing of the 3D plot. For every
+# (size, metric) series it scans all split points for the largest mean
+# shift relative to the run-to-run noise, then aggregates flagged series
+# into a ranked shortlist of suspect commits with confidence scores and
+# affected size ranges. Stdlib-only on purpose: it runs on machines that
+# have none of the plotting deps installed.
+
+METRICS = ["op_busbw(GB/s)", "ip_busbw(GB/s)", "op_time(us)"]
+# metrics where a drop (not a rise) is the regression direction
+HIGHER_IS_BETTER = {"op_busbw(GB/s)", "ip_busbw(GB/s)"}
+MIN_SEGMENT = 3       # commits required on each side of a split
+Z_THRESHOLD = 3.0     # flag a series only above this mean-shift score
+
+def load_series(results):
+    """
+    Turn perfmetricsRun results ([{index, commit, data}, ...]) into
+    {(size, metric): [(commit, [values...]), ...]} ordered oldest commit
+    first (get_last_n_commit_hashes uses git log --reverse, so index 0 is
+    the oldest commit and index ascends toward newer ones).
+    parse_rccl_tests_output can yield several rows per size per run; all
+    of them are kept so the noise estimate sees the run-to-run spread.
+    """
+    ordered = sorted(results, key=lambda e: int(e["index"]))
+    series = defaultdict(list)
+    for entry in ordered:
+        per_commit = defaultdict(list)
+        for row in entry.get("data", []):
+            for metric in METRICS:
+                if metric in row:
+                    per_commit[(int(row["size"]), metric)].append(float(row[metric]))
+        for key, values in per_commit.items():
+            series[key].append((entry["commit"], values))
+    return series
+
+def _mean(xs):
+    return sum(xs) / len(xs)
+
+def _noise_sigma(points):
+    """
+    Per-commit noise estimate: within-commit spread when runs repeat,
+    otherwise a robust estimate from successive differences (median
+    |diff| / 0.6745 / sqrt(2)) so a single level shift doesn't inflate it.
+    """
+    within = []
+    for _, values in points:
+        if len(values) > 1:
+            m = _mean(values)
+            within.append(math.sqrt(sum((v - m) ** 2 for v in values) / (len(values) - 1)))
+    if within:
+        return max(_mean(within), 1e-12)
+    means = [_mean(values) for _, values in points]
+    diffs = sorted(abs(b - a) for a, b in zip(means, means[1:]))
+    if not diffs:
+        return 1e-12
+    median = diffs[len(diffs) // 2]
+    return max(median / 0.6745 / math.sqrt(2), 1e-12)
+
+def detect_change_point(points, min_segment=MIN_SEGMENT):
+    """
+    Best single change point in one series ([(commit, [values]), ...]).
+    Returns (split_index, z_score, left_mean, right_mean) or None when the
+    series is too short. split_index is the first commit of the new regime.
+    """
+    n = len(points)
+    if n < 2 * min_segment:
+        return None
+    means = [_mean(values) for _, values in points]
+    sigma = _noise_sigma(points)
+    best = None
+    for k in range(min_segment, n - min_segment + 1):
+        left, right = means[:k], means[k:]
+        lm, rm = _mean(left), _mean(right)
+        z = abs(rm - lm) / (sigma * math.sqrt(1.0 / len(left) + 1.0 / len(right)))
+        if best is None or z > best[1]:
+            best = (k, z, lm, rm)
+    return best
+
+def rank_suspects(results, z_threshold=Z_THRESHOLD):
+    """
+    Ranked list of suspect commits aggregated across all flagged
+    (size, metric) series. Each entry has the commit, a 0-1 confidence
+    (normal-tail transform of the best z score), the affected size range,
+    and the worst relative change observed.
+    """
+    series = load_series(results)
+    by_commit = defaultdict(list)
+    for (size, metric), points in series.items():
+        found = detect_change_point(points)
+        if found is None:
+            continue
+        k, z, lm, rm = found
+        if z < z_threshold:
+            continue
+        regression = (rm < lm) if metric in HIGHER_IS_BETTER else (rm > lm)
+        change_pct = (rm - lm) / lm * 100.0 if lm else 0.0
+        by_commit[points[k][0]].append({
+            "size": size, "metric": metric, "z": z,
+            "change_pct": change_pct, "regression": regression,
+        })
+    suspects = []
+    for commit, hits in by_commit.items():
+        best_z = max(h["z"] for h in hits)
+        sizes = sorted(h["size"] for h in hits)
+        worst = max(hits, key=lambda h: abs(h["change_pct"]))
+        suspects.append({
+            "commit": commit,
+            "confidence": math.erf(best_z / math.sqrt(2.0)),
+            "series_flagged": len(hits),
+            "regressions": sum(1 for h in hits if h["regression"]),
+            "size_min": sizes[0],
+            "size_max": sizes[-1],
+            "worst_change_pct": worst["change_pct"],
+            "worst_metric": worst["metric"],
+        })
+    suspects.sort(key=lambda s: (-s["regressions"], -s["confidence"], -s["series_flagged"]))
+    return suspects
+
+if __name__ == "__main__":
+    parser = argparse.ArgumentParser(description="Rank suspect commits from perfmetricsRun results")
+    parser.add_argument("results_json", help="results.json written by perfmetricsRun.py")
+    parser.add_argument("--threshold", type=float, default=Z_THRESHOLD,
+                        help="minimum mean-shift z score to flag a series")
+    args = parser.parse_args()
+    with open(args.results_json) as f:
+        results = json.load(f)
+    suspects = rank_suspects(results, z_threshold=args.threshold)
+    if not suspects:
+        print("No change points above threshold")
+    else:
+        print(f"{'commit':<42}{'conf':>6}{'series':>8}{'regr':>6}{'sizes':>24}{'worst change':>16}")
+        for s in suspects:
+            size_range = f"{s['size_min']}..{s['size_max']}"
+            print(f"{s['commit']:<42}{s['confidence']:>6.3f}{s['series_flagged']:>8}"
+                  f"{s['regressions']:>6}{size_range:>24}"
+                  f"{s['worst_change_pct']:>+14.1f}% {s['worst_metric']}")
@@ -1,6 +1,8 @@
 import os
 import subprocess
 import json
+import math
+import shutil
 from pathlib import Path
 from typing import Optional
 import re
@@ -10,6 +12,7 @@ from typing import Optional, Dict
 import pandas as pd
 import plotly.graph_objects as go
 from typing import List
+from viz import peak_preserving_downsample
 
 def get_last_n_commit_hashes(repo_path, n):
     if not os.path.isdir(repo_path):
@@ -86,14 +89,47 @@ def clone_rccl_tests(scratch_dir: str, repo_url: str = "https://github.com/ROCm/
     return rccl_tests_path
 
 
-def build_rccl(rccl_dir: str, commit_hash: Optional[str] = None, jobs: int = 32) -> str:
+# Shared artifact cache for build_rccl: identical (commit, flags) builds are
+# copied out once and reused by later bisections or overlapping sweeps.
+# Point RCCL_BUILD_CACHE at a shared location to share across engineers.
+RCCL_BUILD_CACHE_DIR = os.environ.get("RCCL_BUILD_CACHE", os.path.expanduser("~/.cache/rccl-builds"))
+
+def _build_cache_key(rccl_path: Path, commit_hash: str, debug: bool, only_funcs: str) -> Optional[str]:
+    """
+    Cache key for one build: full commit hash plus the flags that change the
+    produced librccl (build type and ONLY_FUNCS). Returns None if the commit
+    cannot be resolved (dirty tree, unknown ref).
+    """
+    try:
+        result = subprocess.run(
+            ["git", "-C", str(rccl_path), "rev-parse", commit_hash],
+            stdout=subprocess.PIPE, stderr=subprocess.PIPE, text=True, check=True
+        )
+    except subprocess.CalledProcessError:
+        return None
+    full_hash = result.stdout.strip()
+    flags = "debug" if debug else "release"
+    funcs = only_funcs.replace("|", "_").replace("/", "_")
+    return f"{full_hash}-{flags}-{funcs}"
+
+def build_rccl(rccl_dir: str, commit_hash: Optional[str] = None, jobs: int = 32,
+               debug: bool = True, only_funcs: str = "AllReduce|Reduce",
+               use_cache: bool = True) -> str:
     """
     Clone a specific commit of RCCL and build it using the install script.
 
+    Consults the shared artifact cache first (keyed by commit hash, build
+    type and ONLY_FUNCS); a hit turns the build into a file copy. Misses
+    build as before — with ccache wired into the compile when available —
+    and populate the cache afterwards.
+
     Args:
         rccl_dir (str): Path to the RCCL repository.
         commit_hash (Optional[str]): Git commit hash to check out before build.
         jobs (int): Number of parallel jobs for the build (default 32).
+        debug (bool): Build with --debug (default True, matching previous behavior).
+        only_funcs (str): ONLY_FUNCS filter passed to install.sh.
+        use_cache (bool): Set False to force a rebuild.
 
     Raises:
         subprocess.CalledProcessError: If any command fails.
@@ -102,6 +138,28 @@ def build_rccl(rccl_dir: str, commit_hash: Optional[str] = None, jobs: int = 32)
     rccl_path = Path(rccl_dir).resolve()
     if not rccl_path.exists():
         raise FileNotFoundError(f"RCCL directory not found: {rccl_path}")
+    build_type = "debug" if debug else "release"
+    built_lib = os.path.join(rccl_path, "build", build_type, "librccl.so.1.0")
+
+    cache_key = _build_cache_key(rccl_path, commit_hash, debug, only_funcs) if (use_cache and commit_hash) else None
+    cached_lib = os.path.join(RCCL_BUILD_CACHE_DIR, cache_key, "librccl.so.1.0") if cache_key else None
+    if cached_lib and os.path.isfile(cached_lib):
+        print(f"📦 RCCL build cache hit: {cache_key}")
+        # Keep the working tree in sync with the artifact: consumers like
+        # the BUILD_RT path compile rccl-tests against this checkout's
+        # headers and install dir, and they must match the returned lib
+        subprocess.run(["git", "-C", str(rccl_path), "checkout", commit_hash], check=True)
+        os.makedirs(os.path.dirname(built_lib), exist_ok=True)
+        shutil.copy2(cached_lib, built_lib)
+        # install.sh creates the soname links on a real build; restore
+        # them here too so DT_NEEDED librccl.so.1 resolves to this copy
+        for alias in ("librccl.so.1", "librccl.so"):
+            alias_path = os.path.join(os.path.dirname(built_lib), alias)
+            if os.path.lexists(alias_path):
+                os.remove(alias_path)
+            os.symlink(os.path.basename(built_lib), alias_path)
+        return built_lib
+
     os.chdir(rccl_path)
     if commit_hash:
         subprocess.run(["git", "checkout", commit_hash], check=True)
@@ -112,13 +170,29 @@ def build_rccl(rccl_dir: str, commit_hash: Optional[str] = None, jobs: int = 32)
     print(f"🔨 Building RCCL with {jobs} jobs...")
     try:
         env = os.environ.copy()
-        env["ONLY_FUNCS"] = "AllReduce|Reduce"
-        result = subprocess.run(["bash","install.sh", "-l","--debug",f"-j{jobs}"],env=env, stdout=subprocess.PIPE, stderr=subprocess.STDOUT,text=True, check=True) 
+        env["ONLY_FUNCS"] = only_funcs
+        # Wire ccache into the underlying cmake compile when available, so
+        # even cache misses share object files across commits
+        if shutil.which("ccache"):
+            env.setdefault("CMAKE_C_COMPILER_LAUNCHER", "ccache")
+            env.setdefault("CMAKE_CXX_COMPILER_LAUNCHER", "ccache")
+        cmd = ["bash","install.sh", "-l",f"-j{jobs}"]
+        if debug:
+            cmd.insert(3, "--debug")
+        result = subprocess.run(cmd,env=env, stdout=subprocess.PIPE, stderr=subprocess.STDOUT,text=True, check=True)
         print("✅ RCCL build completed.")
+        # Populate the cache atomically: copy to a temp name, then rename
+        if cache_key and os.path.isfile(built_lib):
+            cache_dir = os.path.join(RCCL_BUILD_CACHE_DIR, cache_key)
+            os.makedirs(cache_dir, exist_ok=True)
+            tmp_path = os.path.join(cache_dir, f".librccl.so.1.0.tmp.{os.getpid()}")
+            shutil.copy2(built_lib, tmp_path)
+            os.replace(tmp_path, os.path.join(cache_dir, "librccl.so.1.0"))
+            print(f"📦 RCCL build cached: {cache_key}")
     except subprocess.CalledProcessError as e:
         print(e.output)
-    return os.path.join(rccl_path,"build","debug","librccl.so.1.0") 
-    
+    return built_lib
+
 
 
 def build_rccl_tests(
@@ -164,7 +238,8 @@ def run_rccl_test(
     mpi_install_dir: str = "/opt/ompi5",
     rocm_path: str = "/opt/rocm",
     rccl_test_bin_subdir: str = "rccl-tests/build",
-    rt_args_dict:Optional[Dict[str, str]] = None
+    rt_args_dict:Optional[Dict[str, str]] = None,
+    custom_librccl_dir: Optional[str] = None
 ) -> str:
     """
     Run RCCL test for a specified collective and save the debug log.
@@ -177,6 +252,9 @@ def run_rccl_test(
         mpi_install_dir (str): Path to MPI installation.
         rocm_path (str): Path to ROCm installation.
         rccl_test_bin_subdir (str): path to RCCL test binaries directory.
+        custom_librccl_dir (Optional[str]): Directory holding the librccl.so
+            to load, prepended to LD_LIBRARY_PATH (used by the pipelined
+            sweep to run a per-commit artifact while the next one builds).
 
     Returns:
         generated log
@@ -207,6 +285,9 @@ def run_rccl_test(
     env = os.environ.copy()
     env_path = f"{mpi_install_dir}/bin:{rocm_path}/bin:{os.environ['PATH']}"
     env_ld = f"{mpi_install_dir}/lib:{os.environ.get('LD_LIBRARY_PATH', '')}"
+    if custom_librccl_dir:
+        env_ld = f"{custom_librccl_dir}:{env_ld}"
+        env["LD_LIBRARY_PATH"] = env_ld
     cmd = []
     if MPI:
         cmd = [
@@ -229,7 +310,110 @@ def run_rccl_test(
     except subprocess.CalledProcessError as e:
         return str(e.output)
 
+def run_rccl_test_adaptive(
+    coll: str,
+    tag: str,
+    total_ranks: int = 8,
+    workdir: Optional[str] = None,
+    mpi_install_dir: str = "/opt/ompi5",
+    rocm_path: str = "/opt/rocm",
+    rccl_test_bin_subdir: str = "rccl-tests/build",
+    rt_args_dict:Optional[Dict[str, str]] = None,
+    custom_librccl_dir: Optional[str] = None,
+    initial_n: int = 2,
+    max_rounds: int = 5,
+    rel_ci_target: float = 0.05
+):
+    """
+    Variance-driven wrapper around run_rccl_test. A fixed -n gives large
+    sizes the same iteration count as microsecond-scale small sizes even
+    though their variance is far lower, which is most of the sweep's wall
+    time. This runs the full sweep once with a small -n, measures the
+    run-to-run spread per size from the parsed output, and re-runs only
+    the size range whose 95% confidence interval on op_busbw is still
+    wider than rel_ci_target (relative to the mean), until every point is
+    settled or max_rounds is reached.
+
+    Returns:
+        (data, log): data is one entry per (size, type, redop) in the
+        parse_rccl_tests_output schema with metric means over all samples
+        plus a "samples" count; log is the concatenated raw output.
+    """
+    metric_keys = ["op_time(us)", "op_algbw(GB/s)", "op_busbw(GB/s)",
+                   "ip_time(us)", "ip_algbw(GB/s)", "ip_busbw(GB/s)"]
+    samples: Dict[tuple, list] = {}
+    logs = []
+    base_args = dict(rt_args_dict or {})
+    base_args["-n"] = str(initial_n)
+    lo = hi = None   # unsettled size range for the next round
+    for _ in range(max_rounds):
+        args = dict(base_args)
+        if lo is not None:
+            args["-b"] = str(lo)
+            args["-e"] = str(hi)
+        log = run_rccl_test(coll, tag, total_ranks, workdir, mpi_install_dir,
+                            rocm_path, rccl_test_bin_subdir, args, custom_librccl_dir)
+        logs.append(log)
+        rows = parse_rccl_tests_output(log)
+        if not rows:
+            break
+        for row in rows:
+            key = (int(row["size"]), row["type"], row.get("redop", "none"))
+            samples.setdefault(key, []).append(row)
+        unsettled = []
+        for key, key_rows in samples.items():
+            vals = [float(r["op_busbw(GB/s)"]) for r in key_rows]
+            if len(vals) < 2:
+                unsettled.append(key[0])
+                continue
+            mean = sum(vals) / len(vals)
+            var = sum((v - mean) ** 2 for v in vals) / (len(vals) - 1)
+            ci_half = 1.96 * math.sqrt(var / len(vals))
+            if mean <= 0 or ci_half / mean > rel_ci_target:
+                unsettled.append(key[0])
+        if not unsettled:
+            break
+        lo, hi = min(unsettled), max(unsettled)
+    data = []
+    for key in sorted(samples):
+        key_rows = samples[key]
+        entry = dict(key_rows[0])
+        for metric in metric_keys:
+            entry[metric] = sum(float(r[metric]) for r in key_rows) / len(key_rows)
+        # a wrong count in any sample is a failure, never averaged away
+        entry["op_wrong"] = max(int(r["op_wrong"]) for r in key_rows)
+        entry["ip_wrong"] = max(int(r["ip_wrong"]) for r in key_rows)
+        entry["samples"] = len(key_rows)
+        data.append(entry)
+    return data, "\n".join(logs)
+
+_LOG_PARSER_BIN = os.path.join(os.path.dirname(os.path.abspath(__file__)), "logparser", "rccl_log_parser")
+
+def _parse_with_compiled_tool(rccl_tests_log_str):
+    """
+    Parse an rccl-tests log with the compiled parser in scripts/logparser
+    (build it once with `make -C scripts/logparser`). Returns the same list
+    of dicts as the Python regex loop, or None if the tool is unavailable
+    so the caller can fall back.
+    """
+    if not (os.path.isfile(_LOG_PARSER_BIN) and os.access(_LOG_PARSER_BIN, os.X_OK)):
+        return None
+    try:
+        result = subprocess.run(
+            [_LOG_PARSER_BIN],
+            input=rccl_tests_log_str,
+            stdout=subprocess.PIPE,
+            text=True,
+            check=True
+        )
+        return json.loads(result.stdout)
+    except (subprocess.CalledProcessError, json.JSONDecodeError, OSError):
+        return None
+
 def parse_rccl_tests_output(rccl_tests_log_str):
+    data = _parse_with_compiled_tool(rccl_tests_log_str)
+    if data is not None:
+        return data
     data = []
     regexstr1 = r"\s*(-?\d+)\s+(-?\d+)\s+(\S+)\s+(\S+)\s+(-?\d+)\s+(-?\d+(?:\.\d+)?)\s+(-?\d+(?:\.\d+)?)\s+(-?\d+(?:\.\d+)?)\s+(-?\d+)\s+(-?\d+(?:\.\d+)?)\s+(-?\d+(?:\.\d+)?)\s+(-?\d+(?:\.\d+)?)\s+((-?\d+)|N/A)"
     regexstr2 = r"\s*(-?\d+)\s+(-?\d+)\s+(\S+)\s+(-?\d+)\s+(-?\d+(?:\.\d+)?)\s+(-?\d+(?:\.\d+)?)\s+(-?\d+(?:\.\d+)?)\s+(-?\d+)\s+(-?\d+(?:\.\d+)?)\s+(-?\d+(?:\.\d+)?)\s+(-?\d+(?:\.\d+)?)\s+((-?\d+)|N/A)"
@@ -261,21 +445,53 @@ def parse_rccl_tests_output(rccl_tests_log_str):
                 "ip_busbw(GB/s)": float(columns[10+i]),
                 "ip_wrong":np.int64(columns[11+i]) if columns[11+i].isdigit() or (columns[11+i][1:].isdigit() if columns[11+i].startswith('-') else False) else 0,
             }
-        data.append(entry)          
+        data.append(entry)
     return data
 
+def convert_log_to_columnar(log_path, columnar_path=None):
+    """
+    Parse a tee'd rccl-tests .txt/.log once and persist the rows as a
+    Parquet file next to it, with the exact schema parse_rccl_tests_output
+    produces. Downstream loaders prefer the Parquet file, so report
+    generation over old perfdata_* directories skips the regex work.
+    Returns the written path, or None if there was nothing to write or no
+    Parquet engine (pyarrow/fastparquet) is installed.
+    """
+    if columnar_path is None:
+        columnar_path = os.path.splitext(log_path)[0] + ".parquet"
+    with open(log_path) as f:
+        data = parse_rccl_tests_output(f.read())
+    if not data:
+        return None
+    try:
+        pd.DataFrame(data).to_parquet(columnar_path, index=False)
+    except (ImportError, ValueError) as e:
+        print(f"⚠️ Could not write {columnar_path}: {e}")
+        return None
+    return columnar_path
+
+def load_columnar_results(columnar_path):
+    """
+    Read a Parquet results file back into the same list-of-dicts form that
+    parse_rccl_tests_output returns.
+    """
+    return pd.read_parquet(columnar_path).to_dict(orient="records")
+
 
 def generate_rccl_3d_plot(
     json_path: str,
     html_output: str,
-    metrics: List[str] = None
+    metrics: List[str] = None,
+    max_points: int = 50000
 ) -> None:
     """
     Reads JSON performance data and outputs an HTML file with an interactive 3D scatter plot.
-    
+
     json_path: path to JSON file (commit_hash -> list of dicts)
     html_output: path for the output .html plot
     metrics: list of metric field names for Z-axis dropdown
+    max_points: total point budget across commits; larger datasets are
+        decimated per commit with the peak-preserving downsampler
     """
     # Load data
     with open(json_path) as f:
@@ -306,14 +522,25 @@ def generate_rccl_3d_plot(
             "ip_busbw(GB/s)",
         ]
 
+    # Decimate each commit series and precompute every array once; the
+    # dropdown buttons then reference the shared per-metric z lists
+    # instead of rebuilding a full copy per button. Scatter3d already
+    # renders through WebGL — point count, not the renderer, is what made
+    # big bisection plots take half a minute to open.
+    commits = sorted(df['commit'].unique())
+    per_commit_budget = max(max_points // max(len(commits), 1), 2 * len(metrics) + 2)
+    subs = {c: peak_preserving_downsample(df[df['commit'] == c], metrics, per_commit_budget)
+            for c in commits}
+    z_by_metric = {m: [subs[c][m].tolist() for c in commits] for m in metrics}
+
     # Build traces: one per commit, but we map across all points per commit
     traces = []
-    for commit in sorted(df['commit'].unique()):
-        sub = df[df['commit'] == commit]
+    for ci, commit in enumerate(commits):
+        sub = subs[commit]
         trace = go.Scatter3d(
-            x=sub['size'],
+            x=sub['size'].tolist(),
             y=[commit] * len(sub),  # treat commit as categorical axis
-            z=sub[metrics[0]],       # placeholder, will be updated
+            z=z_by_metric[metrics[0]][ci],
             mode='markers',
             name=commit,
             marker=dict(size=4),
@@ -326,8 +553,8 @@ def generate_rccl_3d_plot(
     for m in metrics:
         buttons.append(dict(
             args=[
-                # Update Z data array in each trace
-                {'z': [df[df['commit']==c][m] for c in sorted(df['commit'].unique())]},
+                # Update Z data array in each trace (shared, not copied)
+                {'z': z_by_metric[m]},
                 {'scene': {'zaxis': {'title': m}}}
             ],
             label=m,
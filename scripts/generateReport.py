@@ -7,7 +7,9 @@ import os
 import re
 import io
 import numpy as np
+from concurrent.futures import ProcessPoolExecutor, as_completed
 from common import parse_rccl_tests_output
+from resultsdb import append_results
 
 def read_file_as_string(filepath):
     with open(filepath, 'r', encoding='utf-8') as f:
@@ -33,16 +35,42 @@ def concat_dataframes_with_key(df_map: dict[str, pd.DataFrame], column_name: str
         df_list.append(df_copy)
     return pd.concat(df_list, ignore_index=True)
 
-def read_folder_to_DFs(folder_path):
-    rvList = {}
+def _load_result_file(filepath):
+    """
+    Ingestion pool worker: one .log/.txt file -> (filename, DataFrame or
+    None). Prefers the columnar file the sweep writes next to the log:
+    a parquet read is milliseconds vs. re-running the parser.
+    """
+    filename = os.path.basename(filepath)
+    parquet_path = os.path.splitext(filepath)[0] + ".parquet"
+    if os.path.isfile(parquet_path):
+        df = pd.read_parquet(parquet_path)
+        return filename, (df if not df.empty else None)
+    data = parse_rccl_tests_output(read_file_as_string(filepath))
+    return filename, (pd.DataFrame(data) if data else None)
+
+def iter_folder_DFs(folder_path, max_workers=None):
+    """
+    Parse every .log/.txt in folder_path on a process pool and yield
+    (filename, df) pairs as each file completes, so downstream stages can
+    start consuming while the archive is still being parsed.
+    """
+    paths = []
     for filename in os.listdir(folder_path):
         filepath = os.path.join(folder_path, filename)
         if os.path.isfile(filepath) and (filename.endswith(".log") or filename.endswith(".txt")):
-            data = parse_rccl_tests_output(read_file_as_string(filepath))
-            if data:  # Only add sheets if there is data
-                df = pd.DataFrame(data)
-                rvList[filename] = df
-    return rvList
+            paths.append(filepath)
+    if not paths:
+        return
+    with ProcessPoolExecutor(max_workers=max_workers) as pool:
+        futures = [pool.submit(_load_result_file, p) for p in paths]
+        for future in as_completed(futures):
+            filename, df = future.result()
+            if df is not None:
+                yield filename, df
+
+def read_folder_to_DFs(folder_path):
+    return dict(iter_folder_DFs(folder_path))
 
 
 def scatter_df_to_excel_tasks_by_columns(
@@ -229,12 +257,42 @@ def write_custom_excel_sheet(
 def getBKCText(BKCversion:str,IFWI:str,RCCLversion:str, HIPverison:str, ROCMversion:str)-> str:
     return f"BKC:{BKCversion}\n IFWI:{IFWI}\n\n RCCL:{RCCLversion}\n HIP:{HIPverison}\n ROCm:{ROCMversion}"
 
-def generateXLSXReport(data_folder_path:str, output_dir:str,bkcinfo:str,cmdstr:str, TransferBenchBW:str):
-    datasetdict = read_folder_to_DFs(folder_path)
+def write_raw_workbook_streaming(split_data, full_path):
+    """
+    Constant-memory dump of the grouped data using openpyxl's write-only
+    mode. The styled per-dtype workbooks from write_custom_excel_sheet
+    need merged cells and workbook reopening, which write-only mode does
+    not support, so this is a separate unstyled artifact for
+    archive-scale runs where holding every styled sheet in memory is the
+    bottleneck.
+    """
+    wb = Workbook(write_only=True)
+    for elem in split_data:
+        title = f"{elem['filename'].removesuffix('.xlsx')}_{elem['sheetname']}"[:31]
+        ws = wb.create_sheet(title=title)
+        df = elem['df']
+        ws.append(list(df.columns))
+        for row in dataframe_to_rows(df, index=False, header=False):
+            ws.append(row)
+    wb.save(full_path)
+
+def generateXLSXReport(data_folder_path:str, output_dir:str,bkcinfo:str,cmdstr:str, TransferBenchBW:str, results_db:str=None, commit_hash:str=None, raw_workbook_path:str=None):
+    # Ingestion is parallel and streamed: each file's rows enter the
+    # pipeline (and the results index) as soon as its worker finishes
+    datasetdict = {}
+    for fname, df in iter_folder_DFs(data_folder_path):
+        datasetdict[fname] = df
+        # Index into the shared results store so later regression queries
+        # don't have to re-parse the perfdata directory
+        if results_db and commit_hash:
+            coll = fname.removesuffix(".txt").removesuffix(".log")
+            append_results(results_db, commit_hash, coll, df.to_dict(orient="records"))
     combinedDF = concat_dataframes_with_key(datasetdict,"coll")
     group_cols = ['size','elements','type','redop','root',"coll"]
     combinedDF = combinedDF.groupby(group_cols,as_index=False).mean().sort_values(by=['coll','type','elements'])
     split_data = scatter_df_to_excel_tasks_by_columns(combinedDF,dtype_col='type',collective_col='coll')
+    if raw_workbook_path:
+        write_raw_workbook_streaming(split_data, raw_workbook_path)
     # writeDFToExcel(combinedDF,"combinedDF.xlsx")
     header_row_texts = ["size\n[H]","size\n[B]","count\n(elements)","type","redop","root","time\n(us)","algbw\n(GB/s)","bus\n(GB/s)","#wrong","time\n(us)","algbw\n(GB/s)","bus\n(GB/s)","#wrong"]
     for elem in split_data:
@@ -253,6 +311,7 @@ if __name__ == "__main__":
     HipVersion = input("Enter HIP Version: ") or ""
     ROCmVersion = input("Enter ROCm Version: ") or ""
     TransferBenchBW = input("Enter TransferBench BW: ") or "? GB/s"
+    results_db = input("Enter results DB path [blank to skip indexing]: ") or None
     box1_text = getBKCText(bkcText,ifwiText,RcclVersion,HipVersion,ROCmVersion)
     box2_text = "${MPI_INSTALL_DIR}/bin/mpirun -np ${total} --bind-to numa -env NCCL_DEBUG=VERSION -env PATH=${MPI_INSTALL_DIR}/bin:${ROCM_PATH}/bin:$PATH -env LD_LIBRARY_PATH=${RCCL_INSTALL_DIR}/lib:${MPI_INSTALL_DIR}/lib:$LD_LIBRARY_PATH ${WORKDIR}/rccl-tests/build/${coll}_perf -b 1 -e 16G -f 2 -g 1 -d all -n 20 -w 5 -N 10"
-    generateXLSXReport(folder_path, output_dir,box1_text, box2_text,TransferBenchBW)
\ No newline at end of file
+    generateXLSXReport(folder_path, output_dir,box1_text, box2_text,TransferBenchBW, results_db=results_db, commit_hash=RcclVersion)
\ No newline at end of file
@@ -0,0 +1,236 @@
+// Compiled replacement for the regex loop in parse_rccl_tests_output
+// (scripts/common.py). Memory-maps the log (or reads stdin), scans each
+// line with branch-light column splitting, and emits the same dict schema
+// as a JSON array so common.py can json.loads the output directly.
+//
+// Usage:
+//   rccl_log_parser <logfile>     # mmap the file
+//   rccl_log_parser               # read the log from stdin
+//
+// Numeric fields are echoed verbatim from the log text, so values match
+// the Python parser bit-for-bit after json.loads.
+
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace {
+
+bool is_int(const char* s, size_t n) {
+    if (n == 0)
+        return false;
+    size_t i = (s[0] == '-') ? 1 : 0;
+    if (i == n)
+        return false;
+    for (; i < n; i++)
+        if (s[i] < '0' || s[i] > '9')
+            return false;
+    return true;
+}
+
+bool is_float(const char* s, size_t n) {
+    if (n == 0)
+        return false;
+    size_t i = (s[0] == '-') ? 1 : 0;
+    size_t digits = 0, dots = 0;
+    for (; i < n; i++) {
+        if (s[i] >= '0' && s[i] <= '9') {
+            digits++;
+        } else if (s[i] == '.') {
+            if (++dots > 1)
+                return false;
+        } else {
+            return false;
+        }
+    }
+    return digits > 0;
+}
+
+bool is_int_or_na(const char* s, size_t n) {
+    return is_int(s, n) || (n == 3 && std::memcmp(s, "N/A", 3) == 0);
+}
+
+struct Token {
+    const char* p;
+    size_t n;
+};
+
+// Splits a line on spaces/tabs; stops early once we have enough columns
+size_t split_columns(const char* line, size_t len, Token* out, size_t maxTokens) {
+    size_t count = 0;
+    size_t i = 0;
+    while (i < len && count < maxTokens) {
+        while (i < len && (line[i] == ' ' || line[i] == '\t'))
+            i++;
+        if (i >= len)
+            break;
+        size_t start = i;
+        while (i < len && line[i] != ' ' && line[i] != '\t')
+            i++;
+        out[count].p = line + start;
+        out[count].n = i - start;
+        count++;
+    }
+    return count;
+}
+
+void append_token(std::string& out, const Token& t) {
+    out.append(t.p, t.n);
+}
+
+// wrong-count columns: N/A (or anything non-integer) becomes 0, matching
+// the Python parser
+void append_wrong(std::string& out, const Token& t) {
+    if (is_int(t.p, t.n))
+        out.append(t.p, t.n);
+    else
+        out.push_back('0');
+}
+
+void append_json_string(std::string& out, const Token& t) {
+    out.push_back('"');
+    for (size_t i = 0; i < t.n; i++) {
+        char c = t.p[i];
+        if (c == '"' || c == '\\')
+            out.push_back('\\');
+        out.push_back(c);
+    }
+    out.push_back('"');
+}
+
+// Emits one JSON object for a data line, or returns false if the line does
+// not match either rccl-tests table layout (with or without a redop column)
+bool emit_line(const char* line, size_t len, std::string& out, bool first) {
+    if (len == 0 || line[0] == '#')
+        return false;
+
+    Token cols[16];
+    size_t n = split_columns(line, len, cols, 16);
+    if (n < 12)
+        return false;
+
+    // Layout 1 (13+ cols, with redop): size elements type redop root
+    //   op_time op_algbw op_busbw op_wrong ip_time ip_algbw ip_busbw ip_wrong
+    // Layout 2 (12+ cols, no redop): same without the redop column
+    bool withRedop =
+        n >= 13 &&
+        is_int(cols[0].p, cols[0].n) && is_int(cols[1].p, cols[1].n) &&
+        !is_float(cols[3].p, cols[3].n) &&  // redop is a word, not a number
+        is_int(cols[4].p, cols[4].n) &&
+        is_float(cols[5].p, cols[5].n) && is_float(cols[6].p, cols[6].n) &&
+        is_float(cols[7].p, cols[7].n) && is_int(cols[8].p, cols[8].n) &&
+        is_float(cols[9].p, cols[9].n) && is_float(cols[10].p, cols[10].n) &&
+        is_float(cols[11].p, cols[11].n) && is_int_or_na(cols[12].p, cols[12].n);
+
+    bool withoutRedop =
+        !withRedop &&
+        is_int(cols[0].p, cols[0].n) && is_int(cols[1].p, cols[1].n) &&
+        is_int(cols[3].p, cols[3].n) &&
+        is_float(cols[4].p, cols[4].n) && is_float(cols[5].p, cols[5].n) &&
+        is_float(cols[6].p, cols[6].n) && is_int(cols[7].p, cols[7].n) &&
+        is_float(cols[8].p, cols[8].n) && is_float(cols[9].p, cols[9].n) &&
+        is_float(cols[10].p, cols[10].n) && is_int_or_na(cols[11].p, cols[11].n);
+
+    if (!withRedop && !withoutRedop)
+        return false;
+
+    size_t i = withRedop ? 1 : 0;
+
+    if (!first)
+        out.push_back(',');
+    out.append("\n{\"size\":");
+    append_token(out, cols[0]);
+    out.append(",\"elements\":");
+    append_token(out, cols[1]);
+    out.append(",\"type\":");
+    append_json_string(out, cols[2]);
+    out.append(",\"redop\":");
+    if (withRedop)
+        append_json_string(out, cols[3]);
+    else
+        out.append("\"none\"");
+    out.append(",\"root\":");
+    append_token(out, cols[3 + i]);
+    out.append(",\"op_time(us)\":");
+    append_token(out, cols[4 + i]);
+    out.append(",\"op_algbw(GB/s)\":");
+    append_token(out, cols[5 + i]);
+    out.append(",\"op_busbw(GB/s)\":");
+    append_token(out, cols[6 + i]);
+    out.append(",\"op_wrong\":");
+    append_wrong(out, cols[7 + i]);
+    out.append(",\"ip_time(us)\":");
+    append_token(out, cols[8 + i]);
+    out.append(",\"ip_algbw(GB/s)\":");
+    append_token(out, cols[9 + i]);
+    out.append(",\"ip_busbw(GB/s)\":");
+    append_token(out, cols[10 + i]);
+    out.append(",\"ip_wrong\":");
+    append_wrong(out, cols[11 + i]);
+    out.push_back('}');
+    return true;
+}
+
+void parse_buffer(const char* data, size_t len, std::string& out) {
+    out.push_back('[');
+    bool first = true;
+    size_t lineStart = 0;
+    for (size_t i = 0; i <= len; i++) {
+        if (i == len || data[i] == '\n') {
+            if (emit_line(data + lineStart, i - lineStart, out, first))
+                first = false;
+            lineStart = i + 1;
+        }
+    }
+    out.append("\n]\n");
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    std::string out;
+    out.reserve(1 << 20);
+
+    if (argc > 1) {
+        int fd = open(argv[1], O_RDONLY);
+        if (fd < 0) {
+            std::perror(argv[1]);
+            return 1;
+        }
+        struct stat st;
+        if (fstat(fd, &st) != 0) {
+            std::perror("fstat");
+            close(fd);
+            return 1;
+        }
+        if (st.st_size > 0) {
+            void* map = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (map == MAP_FAILED) {
+                std::perror("mmap");
+                close(fd);
+                return 1;
+            }
+            parse_buffer((const char*)map, st.st_size, out);
+            munmap(map, st.st_size);
+        } else {
+            parse_buffer("", 0, out);
+        }
+        close(fd);
+    } else {
+        std::string input;
+        char buf[1 << 16];
+        ssize_t n;
+        while ((n = read(STDIN_FILENO, buf, sizeof(buf))) > 0)
+            input.append(buf, n);
+        parse_buffer(input.data(), input.size(), out);
+    }
+
+    std::fwrite(out.data(), 1, out.size(), stdout);
+    return 0;
+}
@@ -1,5 +1,11 @@
 from common import *
+from resultsdb import append_results
+from telemetry import TelemetrySampler, attach_telemetry
 import json
+import shutil
+import time
+from queue import Queue
+from threading import Thread
 
 def getRcclPath(scratch_workdir):
     return os.path.join(scratch_workdir,"rccl")
@@ -9,6 +15,51 @@ def getLibrcclPath(scratch_workdir):
     return os.path.join(scratch_workdir,"rccl","build","debug","librccl.so.1.0") 
 def getRcclTestsBinDir(scratch_workdir):
     return os.path.join(scratch_workdir,"rccl-tests","build")
+def getArtifactDir(scratch_workdir, commit):
+    return os.path.join(scratch_workdir,"builds",commit)
+
+def save_checkpoint(results, output_json):
+    # Write-to-temp + rename so an interrupt never leaves a truncated
+    # results.json behind
+    tmp_path = f"{output_json}.tmp.{os.getpid()}"
+    with open(tmp_path, "w") as f:
+        json.dump(results, f, default=str, indent=2)
+    os.replace(tmp_path, output_json)
+
+def load_checkpoint(output_json, backup_dir, commits):
+    """
+    Rebuild state from a previous interrupted run: parsed entries from
+    results.json, plus any per-commit backup logs written after the last
+    checkpoint. Returns (results, done_commits) so the driver can skip
+    straight to the first missing commit.
+    """
+    results = []
+    done = set()
+    commit_set = set(commits)
+    if os.path.isfile(output_json):
+        try:
+            with open(output_json) as f:
+                loaded = json.load(f)
+            for entry in loaded:
+                commit = entry.get("commit")
+                if commit in commit_set and commit not in done and entry.get("data"):
+                    results.append(entry)
+                    done.add(commit)
+        except (json.JSONDecodeError, OSError):
+            print(f"⚠️ {output_json} is partially written, recovering from backup logs")
+    # Runs completed between checkpoints left a backup log but no entry
+    for idx, commit in enumerate(commits):
+        if commit in done:
+            continue
+        log_path = os.path.join(backup_dir, f"{commit}.log")
+        if os.path.isfile(log_path):
+            with open(log_path) as f:
+                data = parse_rccl_tests_output(f.read())
+            if data:
+                results.append({"index": idx, "commit": commit, "data": data})
+                done.add(commit)
+    results.sort(key=lambda e: int(e["index"]))
+    return results, done
 
 def write_to_log(message: str, file_path: str):
     try:
@@ -26,6 +77,7 @@ if __name__ == "__main__":
     CLONE_RT = 0
     BUILD_RCCL = 1
     BUILD_RT = 0
+    ADAPTIVE_ITERS = 1  # variance-driven re-runs instead of a fixed -n
     rccl_path:str = getRcclPath(scratch_workdir)
     rccl_tests_path:str = getRcclTestsPath(scratch_workdir)
     librccl:str = getLibrcclPath(scratch_workdir)
@@ -38,23 +90,90 @@ if __name__ == "__main__":
         
     N = 10*17
     lastNCommits = get_last_n_commit_hashes(rccl_path, N)
-    results = []
     output_json = os.path.join(scratch_workdir,"results.json")
-    for idx, commit in enumerate(lastNCommits[0:10]):
-        if BUILD_RCCL:
-            librccl = build_rccl(rccl_path,commit_hash=commit)
+    backup_dir = os.path.join(scratch_workdir,"backup")
+    results_db = os.path.join(scratch_workdir,"results.db")
+    commits = lastNCommits[0:10]
+
+    # Resume support: skip commits whose parsed data already exists, so a
+    # restart costs only the remaining work
+    results, done_commits = load_checkpoint(output_json, backup_dir, commits)
+    pending = [(idx, commit) for idx, commit in enumerate(commits) if commit not in done_commits]
+    if done_commits:
+        print(f"⏩ Resuming: {len(done_commits)} commits already done, {len(pending)} remaining")
+
+    # Two-stage build/run pipeline: the builder thread checks out and builds
+    # commit N+1 on the CPUs while commit N runs on the GPUs. Each build is
+    # copied into its own artifact directory so the run loads a stable
+    # librccl while the shared checkout moves on to the next commit. The
+    # bounded queue keeps the builder at most one commit ahead.
+    build_queue = Queue(maxsize=1)
+    build_error = []
+
+    def builder():
+        # The sentinel must reach the queue even when a checkout or build
+        # raises, or the run loop blocks forever on get(); the error is
+        # kept so the driver can abort loudly after saving progress
+        try:
+            for idx, commit in pending:
+                lib = librccl
+                if BUILD_RCCL:
+                    lib = build_rccl(rccl_path,commit_hash=commit)
+                if not os.path.isfile(lib):
+                    raise FileNotFoundError(f"librccl missing after build of {commit}: {lib}")
+                artifact_dir = getArtifactDir(scratch_workdir, commit)
+                os.makedirs(artifact_dir, exist_ok=True)
+                shutil.copy2(lib, os.path.join(artifact_dir, os.path.basename(lib)))
+                # RCCL sets SOVERSION 1, so the rccl-tests binaries carry
+                # DT_NEEDED librccl.so.1 and the loader searches
+                # LD_LIBRARY_PATH for that exact name; without these
+                # aliases every run would silently load the system copy
+                for alias in ("librccl.so.1", "librccl.so"):
+                    alias_path = os.path.join(artifact_dir, alias)
+                    if os.path.lexists(alias_path):
+                        os.remove(alias_path)
+                    os.symlink(os.path.basename(lib), alias_path)
+                build_queue.put((idx, commit, artifact_dir))
+        except Exception as e:
+            print(f"❌ Builder failed at commit {commit}: {e}")
+            build_error.append(e)
+        finally:
+            build_queue.put(None)
+
+    builder_thread = Thread(target=builder, daemon=True)
+    builder_thread.start()
+
+    # Samples GPU clocks/power/temp at ~100ms during each run so a busbw
+    # dip can be attributed to throttling without a rerun; no-op when
+    # rocm-smi is unavailable
+    sampler = TelemetrySampler()
+    sampler.start()
+
+    while True:
+        item = build_queue.get()
+        if item is None:
+            break
+        idx, commit, artifact_dir = item
         if BUILD_RT:
-            rccltests_binaries_path = build_rccl_tests(rccl_tests_path,custom_rccl=librccl,rccl_install=os.path.join(rccl_path,"build","debug"))
+            rccltests_binaries_path = build_rccl_tests(rccl_tests_path,custom_rccl=os.path.join(artifact_dir,"librccl.so.1.0"),rccl_install=os.path.join(rccl_path,"build","debug"))
         rt_args = {"-n":"2"}
-        outputlog = run_rccl_test("all_reduce",0,8,scratch_workdir,rccl_test_bin_subdir=rccltests_binaries_path,rt_args_dict=rt_args)
-        data = parse_rccl_tests_output(outputlog)
+        run_start = time.time()
+        if ADAPTIVE_ITERS:
+            data, outputlog = run_rccl_test_adaptive("all_reduce",0,8,scratch_workdir,rccl_test_bin_subdir=rccltests_binaries_path,rt_args_dict=rt_args,custom_librccl_dir=artifact_dir)
+        else:
+            outputlog = run_rccl_test("all_reduce",0,8,scratch_workdir,rccl_test_bin_subdir=rccltests_binaries_path,rt_args_dict=rt_args,custom_librccl_dir=artifact_dir)
+            data = parse_rccl_tests_output(outputlog)
+        attach_telemetry(data, sampler.summarize(run_start, time.time()))
         if data and len(data):
             results.append({ "index": idx,"commit": commit,"data": data})
-            write_to_log(outputlog,os.path.join(scratch_workdir,"backup",f"{commit}.log"))
+            write_to_log(outputlog,os.path.join(backup_dir,f"{commit}.log"))
+            append_results(results_db, commit, "all_reduce", data, commit_index=idx)
         #checkpointing
         if idx%4 == 0:
-            with open(output_json, "w") as f:
-                json.dump(results, f, default=str, indent=2)
-    with open(output_json, "w") as f:
-                json.dump(results, f, default=str, indent=2)
+            save_checkpoint(results, output_json)
+    builder_thread.join()
+    sampler.stop()
+    save_checkpoint(results, output_json)
+    if build_error:
+        raise RuntimeError("build pipeline failed; completed commits are checkpointed") from build_error[0]
 #3717829.PJsession
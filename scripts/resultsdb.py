@@ -0,0 +1,131 @@
+import os
+import sqlite3
+from typing import List, Optional
+
+# Persistent indexed store for rccl-tests results. perfmetricsRun.py and
+# generateReport.py append parsed rows here so questions like "when did
+# float all_reduce busbw at 1GB drop?" become single indexed queries
+# instead of a re-parse of every results.json and perfdata_* directory.
+# Rows are keyed by (commit, collective, dtype, redop, root, size) —
+# rooted collectives are swept over multiple roots, so root is part of
+# the identity; re-appending the same key replaces the old row.
+
+_SCHEMA = """
+CREATE TABLE IF NOT EXISTS results (
+    commit_hash   TEXT NOT NULL,
+    commit_index  INTEGER,
+    collective    TEXT NOT NULL,
+    dtype         TEXT NOT NULL,
+    redop         TEXT NOT NULL DEFAULT 'none',
+    size          INTEGER NOT NULL,
+    elements      INTEGER,
+    root          INTEGER,
+    op_time_us    REAL,
+    op_algbw      REAL,
+    op_busbw      REAL,
+    op_wrong      INTEGER,
+    ip_time_us    REAL,
+    ip_algbw      REAL,
+    ip_busbw      REAL,
+    ip_wrong      INTEGER,
+    recorded_at   TEXT DEFAULT (datetime('now')),
+    UNIQUE (commit_hash, collective, dtype, redop, root, size)
+);
+CREATE INDEX IF NOT EXISTS idx_results_lookup
+    ON results (collective, dtype, size, commit_index);
+"""
+
+# parse_rccl_tests_output keys -> table columns
+_COLUMN_MAP = {
+    "size": "size",
+    "elements": "elements",
+    "type": "dtype",
+    "redop": "redop",
+    "root": "root",
+    "op_time(us)": "op_time_us",
+    "op_algbw(GB/s)": "op_algbw",
+    "op_busbw(GB/s)": "op_busbw",
+    "op_wrong": "op_wrong",
+    "ip_time(us)": "ip_time_us",
+    "ip_algbw(GB/s)": "ip_algbw",
+    "ip_busbw(GB/s)": "ip_busbw",
+    "ip_wrong": "ip_wrong",
+}
+
+def open_results_db(db_path: str) -> sqlite3.Connection:
+    """Open (creating if needed) the results database and ensure the schema exists."""
+    db_dir = os.path.dirname(db_path)
+    if db_dir:
+        os.makedirs(db_dir, exist_ok=True)
+    conn = sqlite3.connect(db_path)
+    conn.executescript(_SCHEMA)
+    return conn
+
+def append_results(db_path: str, commit_hash: str, collective: str,
+                   data: List[dict], commit_index: Optional[int] = None) -> int:
+    """
+    Append one run's parsed rows (the list parse_rccl_tests_output returns)
+    under the given commit and collective. Returns the number of rows written.
+    """
+    if not data:
+        return 0
+    rows = []
+    for entry in data:
+        row = {"commit_hash": commit_hash, "commit_index": commit_index,
+               "collective": collective}
+        for key, col in _COLUMN_MAP.items():
+            value = entry.get(key)
+            # numpy scalars from the Python parser are not sqlite-bindable
+            row[col] = value.item() if hasattr(value, "item") else value
+        rows.append(row)
+    cols = list(rows[0].keys())
+    sql = (f"INSERT OR REPLACE INTO results ({','.join(cols)}) "
+           f"VALUES ({','.join(':' + c for c in cols)})")
+    with open_results_db(db_path) as conn:
+        conn.executemany(sql, rows)
+    return len(rows)
+
+def query_size_series(db_path: str, collective: str, dtype: str, size: int,
+                      metric: str = "op_busbw") -> List[tuple]:
+    """
+    Per-commit time series of one metric at a fixed message size.
+    Returns [(commit_hash, commit_index, value), ...] ordered oldest-first
+    (get_last_n_commit_hashes uses git log --reverse, so commit_index 0 is
+    the oldest commit and ascends toward newer ones).
+    """
+    if metric not in _COLUMN_MAP.values():
+        raise ValueError(f"unknown metric '{metric}', expected one of {sorted(set(_COLUMN_MAP.values()))}")
+    with open_results_db(db_path) as conn:
+        cur = conn.execute(
+            f"SELECT commit_hash, commit_index, {metric} FROM results "
+            "WHERE collective = ? AND dtype = ? AND size = ? "
+            "ORDER BY commit_index ASC, recorded_at ASC",
+            (collective, dtype, size))
+        return cur.fetchall()
+
+def query_commit_delta(db_path: str, collective: str, dtype: str,
+                       commit_a: str, commit_b: str,
+                       metric: str = "op_busbw") -> List[dict]:
+    """
+    Per-size delta of one metric between two commits (b relative to a).
+    Returns [{"size":..., "a":..., "b":..., "delta":..., "delta_pct":...}, ...]
+    for sizes present in both commits.
+    """
+    if metric not in _COLUMN_MAP.values():
+        raise ValueError(f"unknown metric '{metric}', expected one of {sorted(set(_COLUMN_MAP.values()))}")
+    with open_results_db(db_path) as conn:
+        cur = conn.execute(
+            f"SELECT a.size, a.{metric}, b.{metric} FROM results a "
+            "JOIN results b ON a.collective = b.collective AND a.dtype = b.dtype "
+            "AND a.redop = b.redop AND a.root = b.root AND a.size = b.size "
+            "WHERE a.collective = ? AND a.dtype = ? "
+            "AND a.commit_hash = ? AND b.commit_hash = ? ORDER BY a.size",
+            (collective, dtype, commit_a, commit_b))
+        deltas = []
+        for size, va, vb in cur.fetchall():
+            entry = {"size": size, "a": va, "b": vb, "delta": None, "delta_pct": None}
+            if va is not None and vb is not None:
+                entry["delta"] = vb - va
+                entry["delta_pct"] = (vb - va) / va * 100.0 if va else None
+            deltas.append(entry)
+        return deltas
@@ -0,0 +1,103 @@
+import argparse
+import json
+import re
+import sys
+
+# Gate for sweeptest.sh: decides from the hip_api_test structured output
+# (--format=json) whether a node is worth a multi-hour sweep. Prints the
+# comma-separated list of healthy GPU ids on stdout (for
+# HIP_VISIBLE_DEVICES fencing) and exits 0, or exits nonzero when the
+# node should be rejected outright. Stdlib-only: it runs before any of
+# the analysis dependencies are guaranteed to exist on a fresh node.
+
+_DETAIL_RE = re.compile(r"dst=(\d+) gbps=([-\d.eE]+)")
+
+def load_jsonl(path):
+    rows = []
+    try:
+        with open(path) as f:
+            for line in f:
+                line = line.strip()
+                if line:
+                    rows.append(json.loads(line))
+    except (OSError, json.JSONDecodeError) as e:
+        print(f"smokegate: cannot read {path}: {e}", file=sys.stderr)
+    return rows
+
+def bad_links(p2p_rows, min_gbps):
+    """(src, dst) pairs that are unreachable or below the bandwidth floor."""
+    links = set()
+    for row in p2p_rows:
+        if row.get("name") != "p2p_link":
+            continue
+        m = _DETAIL_RE.search(row.get("detail", ""))
+        if m is None:
+            continue
+        src, dst, gbps = int(row["device"]), int(m.group(1)), float(m.group(2))
+        if row.get("status") != "pass" or gbps < min_gbps:
+            links.add((src, dst))
+    return links
+
+def fence_devices(devices, failed, links):
+    """
+    Healthy device set: drop devices with failed suite tests, then
+    greedily drop the device on the most bad links until none remain
+    among the survivors.
+    """
+    good = set(devices) - set(failed)
+    links = {(s, d) for s, d in links if s in good and d in good}
+    while links:
+        counts = {}
+        for s, d in links:
+            counts[s] = counts.get(s, 0) + 1
+            counts[d] = counts.get(d, 0) + 1
+        worst = max(counts, key=lambda dev: (counts[dev], dev))
+        good.discard(worst)
+        links = {(s, d) for s, d in links if s != worst and d != worst}
+    return good
+
+if __name__ == "__main__":
+    parser = argparse.ArgumentParser(description="Validate hip_api_test results before a sweep")
+    parser.add_argument("suite_jsonl", help="functional suite results (--format=json)")
+    parser.add_argument("p2p_jsonl", help="--p2p results (--format=json)")
+    parser.add_argument("--min-gpus", type=int, default=2)
+    parser.add_argument("--min-p2p-gbps", type=float, default=10.0)
+    parser.add_argument("--allow-missing-p2p", action="store_true",
+                        help="pass a multi-GPU node even when no p2p_link rows were captured")
+    args = parser.parse_args()
+
+    suite_rows = load_jsonl(args.suite_jsonl)
+    if not suite_rows:
+        print("smokegate: no suite results, rejecting node", file=sys.stderr)
+        sys.exit(2)
+    devices = {int(r["device"]) for r in suite_rows if int(r.get("device", -1)) >= 0}
+    failed = {int(r["device"]) for r in suite_rows
+              if r.get("status") == "fail" and int(r.get("device", -1)) >= 0}
+    for dev in sorted(failed):
+        tests = [r["name"] for r in suite_rows
+                 if r.get("status") == "fail" and int(r.get("device", -1)) == dev]
+        print(f"smokegate: device {dev} failed {', '.join(tests)}", file=sys.stderr)
+
+    link_rows = [r for r in load_jsonl(args.p2p_jsonl) if r.get("name") == "p2p_link"]
+    if not link_rows and len(devices) >= 2:
+        # A multi-GPU node with zero p2p_link rows means the p2p probe is
+        # missing or crashed before measuring anything — exactly the flaky
+        # link the gate exists to catch, so it must not pass silently
+        msg = "smokegate: no p2p_link rows for a multi-GPU node (p2p probe missing or crashed)"
+        if args.allow_missing_p2p:
+            print(f"{msg}, continuing due to --allow-missing-p2p", file=sys.stderr)
+        else:
+            print(f"{msg}, rejecting node", file=sys.stderr)
+            sys.exit(2)
+
+    links = bad_links(link_rows, args.min_p2p_gbps)
+    for src, dst in sorted(links):
+        print(f"smokegate: link {src}->{dst} unreachable or below "
+              f"{args.min_p2p_gbps} GB/s", file=sys.stderr)
+
+    good = fence_devices(devices, failed, links)
+    if len(good) < args.min_gpus:
+        print(f"smokegate: only {len(good)} healthy GPUs of {len(devices)} "
+              f"(need {args.min_gpus}), rejecting node", file=sys.stderr)
+        sys.exit(2)
+    print(",".join(str(d) for d in sorted(good)))
@@ -1,5 +1,7 @@
 #!/usr/bin/env bash
 
+SCRIPT_DIR=$(cd "$(dirname "${BASH_SOURCE[0]}")" && pwd)
+
 ## change this if ROCm is installed in a non-standard path
 ROCM_PATH=/opt/rocm
 MPI_INSTALL_DIR=/opt/mpich
@@ -12,6 +14,12 @@ build_rccl=1
 rccl_debug_mode=1
 build_rccl_tests=1
 mpi_mode=1
+## Multi-node mode: point hostfile at an MPICH-style hostfile (one host
+## per line, optional :slots suffix) to sweep across nodes. Built
+## artifacts under ${WORKDIR} are synced to each peer over ssh/rsync
+## instead of rebuilding per node; requires passwordless ssh and
+## mpi_mode=1. Leave empty for single-node behavior.
+hostfile=""
  
 #Take the name from user use the following default
 WORKDIR="$PWD/temp"
@@ -71,10 +79,56 @@ then
 fi
 
 ## running rccl-tests sweep
-n_gpus=8                             # assuming 8 GPUs per node
+## Detect device count and VRAM instead of hand-editing per system.
+## Set n_gpus/vram_bytes explicitly before this block to override.
+n_gpus=0
+vram_bytes=0
+if command -v ${ROCM_PATH}/bin/rocm-smi >/dev/null 2>&1
+then
+    n_gpus=$(${ROCM_PATH}/bin/rocm-smi --showid --csv 2>/dev/null | grep -c '^card')
+    ## smallest per-GPU VRAM bounds the sweep end size
+    vram_bytes=$(${ROCM_PATH}/bin/rocm-smi --showmeminfo vram --csv 2>/dev/null | awk -F, '/^card/ {print $2}' | sort -n | head -1)
+fi
+if [ "${n_gpus:-0}" -eq 0 ] && command -v ${ROCM_PATH}/bin/rocminfo >/dev/null 2>&1
+then
+    n_gpus=$(${ROCM_PATH}/bin/rocminfo 2>/dev/null | grep -c 'Device Type:.*GPU')
+fi
+if [ "${n_gpus:-0}" -eq 0 ]
+then
+    n_gpus=8                         # detection unavailable, assume 8 GPUs per node
+    echo "WARNING: could not detect GPU count, assuming ${n_gpus}"
+fi
 n_nodes=1
+hostfile_args=""
+if [ -n "${hostfile}" ]
+then
+    if [ ${mpi_mode} -ne 1 ]
+    then
+        echo "ERROR: multi-node mode requires mpi_mode=1"
+        exit 1
+    fi
+    n_nodes=$(grep -cve '^\s*$' ${hostfile})
+    hostfile_args="-f ${hostfile} -ppn ${n_gpus}"
+    ## distribute the built artifacts so peers don't rebuild; the remote
+    ## paths mirror the local temp layout
+    local_host=$(hostname)
+    rt_build_dir=${WORKDIR}/rocm-systems/projects/rccl-tests/build
+    for host in $(grep -ve '^\s*$' ${hostfile})
+    do
+        host=${host%%:*}    # strip :slots suffix
+        if [ "${host}" = "${local_host}" ] || [ "${host}" = "localhost" ]
+        then
+            continue
+        fi
+        echo "Syncing build artifacts to ${host}"
+        ssh ${host} mkdir -p ${MPI_INSTALL_DIR} ${RCCL_INSTALL_DIR} ${rt_build_dir}
+        rsync -a ${MPI_INSTALL_DIR}/ ${host}:${MPI_INSTALL_DIR}/
+        rsync -a ${RCCL_INSTALL_DIR}/ ${host}:${RCCL_INSTALL_DIR}/
+        rsync -a ${rt_build_dir}/ ${host}:${rt_build_dir}/
+    done
+fi
 total=$((n_gpus * n_nodes))                # total number of MPI ranks (1 per GPU)
-echo "Total ranks: ${total}"    # print number of GPUs
+echo "Detected ${n_gpus} GPUs on ${n_nodes} node(s), total ranks: ${total}"
 cd ${WORKDIR}
 # Get today's UTC date in yyyy_MM_dd format
 DATE_UTC=$(date -u +"%Y_%m_%d")
@@ -82,20 +136,146 @@ DATE_UTC=$(date -u +"%Y_%m_%d")
 PERF_DATA_DIR="perfdata_${DATE_UTC}"
 mkdir -p ${PERF_DATA_DIR}
 
+## Smoke gate: build and run the hip_api_test suite before committing to
+## a multi-hour sweep. smokegate.py validates device count, P2P
+## reachability and link bandwidth from the structured output; unhealthy
+## GPUs are fenced out of the sweep via HIP_VISIBLE_DEVICES, and the node
+## is rejected outright when too few healthy GPUs remain.
+smoke_gate=1
+smoke_min_gpus=2
+smoke_min_p2p_gbps=10
+device_list=($(seq 0 $((n_gpus - 1))))
+if [ ${smoke_gate} -eq 1 ]
+then
+    smoke_dir=${SCRIPT_DIR}/../smoketest/hip_testing
+    if ! make -C ${smoke_dir} BUILD=release
+    then
+        echo "ERROR: smoke suite failed to build, aborting sweep"
+        exit 1
+    fi
+    smoke_bin=${smoke_dir}/build/release/hip_api_test
+    smoke_suite=${WORKDIR}/${PERF_DATA_DIR}/smoke_suite.jsonl
+    smoke_p2p=${WORKDIR}/${PERF_DATA_DIR}/smoke_p2p.jsonl
+    ## nonzero exit here means some test failed; the gate decides from
+    ## the structured output whether that fences a GPU or rejects the node
+    ${smoke_bin} --format=json --output=${smoke_suite} || true
+    ${smoke_bin} --p2p --format=json --output=${smoke_p2p} || true
+    if ! gated_devices=$(python3 ${SCRIPT_DIR}/smokegate.py ${smoke_suite} ${smoke_p2p} --min-gpus ${smoke_min_gpus} --min-p2p-gbps ${smoke_min_p2p_gbps})
+    then
+        echo "ERROR: smoke gate rejected this node, aborting sweep"
+        exit 1
+    fi
+    gated_list=(${gated_devices//,/ })
+    if [ ${#gated_list[@]} -lt ${n_gpus} ]
+    then
+        if [ -n "${hostfile}" ]
+        then
+            ## per-node fencing cannot be expressed through one mpirun env
+            echo "ERROR: smoke gate fenced GPUs on the launch node; fix or drop it from the hostfile"
+            exit 1
+        fi
+        echo "Smoke gate fenced GPUs; sweeping on ${gated_devices}"
+        device_list=(${gated_list[@]})
+        n_gpus=${#device_list[@]}
+        total=$((n_gpus * n_nodes))
+    fi
+fi
+
 #Run parameters
 b=1        #begin size
-e=16G      #end size
+e=16G      #end size (capped below by detected VRAM)
 d=float     #data types
 n=1        #iterations
 w=0        #warm up iterations
 N=1        #stress cycle iterations
- 
-for coll in all_reduce #all_gather alltoall alltoallv broadcast gather reduce reduce_scatter scatter sendrecv
-do
-    # using MPICH; comment next line if using OMPI
+
+## Size the sweep to the hardware: a fixed -e 16G exceeds memory on small
+## devboxes and wastes hours. Cap the largest message at half of the
+## smallest GPU's VRAM, rounded down to a power of two.
+if [ "${vram_bytes:-0}" -gt 0 ]
+then
+    cap=$((vram_bytes / 2))
+    e_bytes=1
+    while [ $((e_bytes * 2)) -le ${cap} ]
+    do
+        e_bytes=$((e_bytes * 2))
+    done
+    if [ ${e_bytes} -lt $((16 * 1024 * 1024 * 1024)) ]
+    then
+        e=${e_bytes}
+        echo "Capping sweep end size at ${e} bytes (smallest GPU VRAM: ${vram_bytes} bytes)"
+    fi
+fi
+
+## Partitioned execution: set partition_size to 2 or 4 to run independent
+## collective jobs concurrently on disjoint GPU subsets (HIP_VISIBLE_DEVICES,
+## as debugging/configs/single_proc_launch.json does for debugging).
+## partition_size=0 keeps the original one-job-at-a-time behavior on all GPUs.
+partition_size=0
+
+## run_collective <coll> <ranks/gpus> <visible_devices>
+run_collective() {
+    local coll=$1
+    local ranks=$2
+    local visible=$3
+    local outfile=${WORKDIR}/${PERF_DATA_DIR}/${coll}.txt
+    # using MPICH; switch the mpirun line if using OMPI
     if [[ $mpi_mode -eq 1 ]]; then
-        ${MPI_INSTALL_DIR}/bin/mpirun -np ${total} --bind-to numa -env NCCL_DEBUG=VERSION -env PATH=${MPI_INSTALL_DIR}/bin:${ROCM_PATH}/bin:$PATH -env LD_LIBRARY_PATH=${RCCL_INSTALL_DIR}:${MPI_INSTALL_DIR}/lib:$LD_LIBRARY_PATH ${WORKDIR}/rocm-systems/projects/rccl-tests/build/${coll}_perf -b ${b} -e ${e} -f 2 -g 1 -d ${d} -n ${n} -w ${w} -N ${N} -M 1 2>&1 | tee ${WORKDIR}/${PERF_DATA_DIR}/${coll}.txt
-    else 
-         NCCL_DEBUG=VERSION PATH=${ROCM_PATH}/bin:$PATH LD_LIBRARY_PATH=${RCCL_INSTALL_DIR}:$LD_LIBRARY_PATH ${WORKDIR}/rocm-systems/projects/rccl-tests/build/${coll}_perf -b ${b} -e ${e} -f 2 -g ${n_gpus} -d ${d} -n ${n} -w ${w} -N ${N} 2>&1 | tee ${WORKDIR}/${PERF_DATA_DIR}/${coll}.txt
-    fi 
-done
\ No newline at end of file
+        ${MPI_INSTALL_DIR}/bin/mpirun -np ${ranks} ${hostfile_args} --bind-to numa -env NCCL_DEBUG=VERSION -env HIP_VISIBLE_DEVICES=${visible} -env PATH=${MPI_INSTALL_DIR}/bin:${ROCM_PATH}/bin:$PATH -env LD_LIBRARY_PATH=${RCCL_INSTALL_DIR}:${MPI_INSTALL_DIR}/lib:$LD_LIBRARY_PATH ${WORKDIR}/rocm-systems/projects/rccl-tests/build/${coll}_perf -b ${b} -e ${e} -f 2 -g 1 -d ${d} -n ${n} -w ${w} -N ${N} -M 1 2>&1 | tee ${outfile}
+    else
+        NCCL_DEBUG=VERSION HIP_VISIBLE_DEVICES=${visible} PATH=${ROCM_PATH}/bin:$PATH LD_LIBRARY_PATH=${RCCL_INSTALL_DIR}:$LD_LIBRARY_PATH ${WORKDIR}/rocm-systems/projects/rccl-tests/build/${coll}_perf -b ${b} -e ${e} -f 2 -g ${ranks} -d ${d} -n ${n} -w ${w} -N ${N} 2>&1 | tee ${outfile}
+    fi
+    ## persist a columnar copy next to the log so report generation reads
+    ## parquet instead of re-parsing the prose
+    python3 -c "import sys; sys.path.insert(0, '${SCRIPT_DIR}'); from common import convert_log_to_columnar; convert_log_to_columnar('${outfile}')" \
+        || echo "WARNING: columnar conversion failed for ${outfile}; the .txt log is still usable"
+}
+
+collectives="all_reduce" #all_gather alltoall alltoallv broadcast gather reduce reduce_scatter scatter sendrecv
+
+all_devices=$(IFS=,; echo "${device_list[*]}")
+
+## partitioning subsets the GPUs of one node; it does not compose with a
+## cross-node sweep
+if [ -n "${hostfile}" ] && [ ${partition_size} -ne 0 ]
+then
+    echo "WARNING: partition_size ignored in multi-node mode"
+    partition_size=0
+fi
+
+if [ ${partition_size} -eq 0 ] || [ ${partition_size} -ge ${n_gpus} ]
+then
+    for coll in ${collectives}
+    do
+        run_collective ${coll} ${total} ${all_devices}
+    done
+else
+    ## Small slot scheduler: one slot per disjoint GPU subset, a job is
+    ## launched only when its slot's previous job has finished, so GPUs are
+    ## never oversubscribed.
+    num_partitions=$((n_gpus / partition_size))
+    declare -a slot_pid
+    for coll in ${collectives}
+    do
+        launched=0
+        while [ ${launched} -eq 0 ]
+        do
+            for s in $(seq 0 $((num_partitions - 1)))
+            do
+                if [ -z "${slot_pid[$s]}" ] || ! kill -0 ${slot_pid[$s]} 2>/dev/null
+                then
+                    first=$((s * partition_size))
+                    slot_devices=("${device_list[@]:${first}:${partition_size}}")
+                    visible=$(IFS=,; echo "${slot_devices[*]}")
+                    echo "Scheduling ${coll} on GPUs ${visible} (slot ${s})"
+                    run_collective ${coll} ${partition_size} ${visible} &
+                    slot_pid[$s]=$!
+                    launched=1
+                    break
+                fi
+            done
+            [ ${launched} -eq 0 ] && sleep 5
+        done
+    done
+    wait
+fi
\ No newline at end of file
@@ -0,0 +1,146 @@
+import re
+import shutil
+import subprocess
+import threading
+import time
+from collections import deque
+from typing import List, Optional
+
+# Background hardware telemetry for sweep runs. When a sweep shows a
+# busbw dip we cannot tell thermal throttling from a software regression
+# without rerunning; this samples rocm-smi counters (clocks, power,
+# temperature, GPU use) on a thread at ~100ms resolution into a ring
+# buffer, and summarize() slices the buffer by wall-clock window so the
+# summary lines up with the collective invocation that was running.
+# Everything degrades to a no-op when rocm-smi is unavailable.
+
+_NUM_RE = re.compile(r"-?\d+(?:\.\d+)?")
+
+def _first_float(text: str) -> Optional[float]:
+    m = _NUM_RE.search(text)
+    return float(m.group(0)) if m else None
+
+class TelemetrySampler:
+    """
+    Polls rocm-smi on a daemon thread into a bounded ring buffer.
+    Use as a context manager around one or more runs, then call
+    summarize(start_ts, end_ts) per run to get an aligned summary.
+    """
+
+    def __init__(self, interval_s: float = 0.1, capacity: int = 36000,
+                 rocm_path: str = "/opt/rocm", smi_bin: Optional[str] = None):
+        self.interval_s = interval_s
+        self.buffer = deque(maxlen=capacity)
+        self._lock = threading.Lock()
+        self._stop = threading.Event()
+        self._thread = None
+        if smi_bin is None:
+            smi_bin = f"{rocm_path}/bin/rocm-smi"
+            if not shutil.which(smi_bin):
+                smi_bin = shutil.which("rocm-smi")
+        self.smi_bin = smi_bin
+
+    @property
+    def available(self) -> bool:
+        return self.smi_bin is not None and shutil.which(self.smi_bin) is not None
+
+    def _sample_once(self) -> List[dict]:
+        try:
+            out = subprocess.run(
+                [self.smi_bin, "--showgpuclocks", "--showpower",
+                 "--showtemp", "--showuse", "--csv"],
+                stdout=subprocess.PIPE, stderr=subprocess.DEVNULL,
+                text=True, timeout=2, check=True).stdout
+        except (subprocess.SubprocessError, OSError):
+            return []
+        lines = [l for l in out.splitlines() if "," in l]
+        if len(lines) < 2:
+            return []
+        # column names vary across rocm-smi versions; match by substring
+        header = [h.strip().lower() for h in lines[0].split(",")]
+        def col(*needles):
+            for i, name in enumerate(header):
+                if all(n in name for n in needles):
+                    return i
+            return None
+        cols = {"sclk_mhz": col("sclk"), "temp_c": col("temperature"),
+                "power_w": col("power"), "use_pct": col("use")}
+        ts = time.time()
+        samples = []
+        for line in lines[1:]:
+            fields = line.split(",")
+            if not fields[0].strip().lower().startswith("card"):
+                continue
+            sample = {"ts": ts, "gpu": fields[0].strip()}
+            for key, idx in cols.items():
+                sample[key] = _first_float(fields[idx]) if idx is not None and idx < len(fields) else None
+            samples.append(sample)
+        return samples
+
+    def _poll_loop(self):
+        while not self._stop.is_set():
+            samples = self._sample_once()
+            if samples:
+                with self._lock:
+                    self.buffer.extend(samples)
+            self._stop.wait(self.interval_s)
+
+    def start(self):
+        if not self.available or self._thread is not None:
+            return
+        self._stop.clear()
+        self._thread = threading.Thread(target=self._poll_loop, daemon=True)
+        self._thread.start()
+
+    def stop(self):
+        if self._thread is None:
+            return
+        self._stop.set()
+        self._thread.join()
+        self._thread = None
+
+    def __enter__(self):
+        self.start()
+        return self
+
+    def __exit__(self, *exc):
+        self.stop()
+        return False
+
+    def summarize(self, start_ts: float, end_ts: float) -> Optional[dict]:
+        """
+        Aggregate all samples that fell inside [start_ts, end_ts] across
+        GPUs. throttle_samples counts samples whose sclk dropped below 90%
+        of the window's peak clock — a cheap proxy for throttling events.
+        Returns None when nothing was captured in the window.
+        """
+        with self._lock:
+            window = [s for s in self.buffer if start_ts <= s["ts"] <= end_ts]
+        if not window:
+            return None
+        def values(key):
+            return [s[key] for s in window if s[key] is not None]
+        summary = {"samples": len(window)}
+        sclks = values("sclk_mhz")
+        if sclks:
+            peak = max(sclks)
+            summary["sclk_min_mhz"] = min(sclks)
+            summary["sclk_mean_mhz"] = sum(sclks) / len(sclks)
+            summary["throttle_samples"] = sum(1 for v in sclks if v < 0.9 * peak)
+        temps = values("temp_c")
+        if temps:
+            summary["temp_max_c"] = max(temps)
+        powers = values("power_w")
+        if powers:
+            summary["power_mean_w"] = sum(powers) / len(powers)
+        uses = values("use_pct")
+        if uses:
+            summary["use_mean_pct"] = sum(uses) / len(uses)
+        return summary
+
+def attach_telemetry(data: List[dict], summary: Optional[dict]) -> List[dict]:
+    """Attach one run's telemetry summary to every parsed result row."""
+    if summary:
+        for row in data:
+            row["telemetry"] = summary
+    return data
@@ -5,6 +5,31 @@ import os
 
 # Assume you have the flatten_json_to_dataframe and plot_dataframe_3d_interactive functions defined as above
 
+def peak_preserving_downsample(df, value_cols, max_points=2000):
+    """
+    Decimate a series DataFrame down to roughly max_points rows while
+    keeping the extremes of every value column: rows are bucketed by
+    position and the per-bucket min and max of each column survive, so a
+    one-commit spike or dip is never averaged out of the plot the way a
+    stride-based decimation would. First and last rows are always kept.
+    """
+    import numpy as np
+    n = len(df)
+    if n <= max_points:
+        return df
+    n_buckets = max(1, max_points // (2 * len(value_cols)))
+    edges = np.linspace(0, n, n_buckets + 1, dtype=int)
+    keep = {0, n - 1}
+    for col in value_cols:
+        vals = df[col].to_numpy()
+        for b in range(n_buckets):
+            lo, hi = edges[b], edges[b + 1]
+            if hi <= lo:
+                continue
+            keep.add(lo + int(np.argmin(vals[lo:hi])))
+            keep.add(lo + int(np.argmax(vals[lo:hi])))
+    return df.iloc[sorted(keep)]
+
 def flatten_json_to_dataframe(json_data):
     """
     Flattens a specific JSON structure into a Pandas DataFrame.
@@ -43,7 +68,8 @@ def plot_dataframe_3d_interactive(
     plot_title: str = "Interactive 3D Plot",
     connect_points: bool = True,
     log_y: bool = True,
-    color_by_deviation: bool = True
+    color_by_deviation: bool = True,
+    max_points: int = 4000
 ):
     import numpy as np
     import plotly.graph_objects as go
@@ -51,9 +77,17 @@ def plot_dataframe_3d_interactive(
     if not all(col in df.columns for col in [x_col, y_col] + dropdown_z_cols):
         raise ValueError("One or more specified columns are not in the DataFrame.")
 
+    # Above max_points the emitted HTML grows into tens of megabytes and
+    # the browser stalls before becoming interactive, so decimate first
+    # (Scatter3d already renders through WebGL; point count, not the
+    # renderer, is the bottleneck)
+    df = peak_preserving_downsample(df, dropdown_z_cols, max_points)
+
     x_axis_title = x_axis_title if x_axis_title is not None else x_col
     y_axis_title = y_axis_title if y_axis_title is not None else (f"log({y_col})" if log_y else y_col)
-    y_data = np.log2(df[y_col]) if log_y else df[y_col]
+    # computed once and shared by every metric trace instead of copied
+    x_data = df[x_col].tolist()
+    y_data = (np.log2(df[y_col]) if log_y else df[y_col]).tolist()
 
     data_traces = []
 
@@ -71,7 +105,7 @@ def plot_dataframe_3d_interactive(
             color_vals = z_data  # or just use a default constant if no coloring
 
         trace = go.Scatter3d(
-            x=df[x_col],
+            x=x_data,
             y=y_data,
             z=z_data,
             mode='lines+markers' if connect_points else 'markers',
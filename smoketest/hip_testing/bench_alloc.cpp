@@ -0,0 +1,58 @@
+#include "hip_api_test.h"
+
+// Stream-ordered allocation latency benchmark (--alloc-bench)
+//
+// Measures steady-state hipMallocAsync/hipFreeAsync latency out of a
+// warmed hipMemPool against the cold hipMalloc/hipFree path the rest of
+// the suite uses, so we know on each ROCm drop whether the pool path
+// actually removes allocation stalls from a hot loop.
+
+static void bench_alloc_latency() {
+    int device = 0;
+    CHECK_HIP(hipGetDevice(&device));
+
+    hipMemPool_t pool;
+    CHECK_HIP(hipDeviceGetDefaultMemPool(&pool, device));
+    uint64_t threshold = UINT64_MAX;
+    CHECK_HIP(hipMemPoolSetAttribute(pool, hipMemPoolAttrReleaseThreshold, &threshold));
+
+    hipStream_t stream;
+    CHECK_HIP(hipStreamCreate(&stream));
+
+    const size_t sizes[] = {1024, 64 * 1024, 4 * 1024 * 1024};
+
+    // The probe size is folded into the row name so the shared helper can
+    // emit both the CSV line and the structured-sink record
+    std::cout << "api,device,iters,min_us,median_us,p99_us\n";
+    for (size_t bytes : sizes) {
+        // Cold path: raw hipMalloc/hipFree, serializing on the device
+        {
+            void* p = nullptr;
+            BenchStats s = bench_loop([&] {
+                CHECK_HIP(hipMalloc(&p, bytes));
+                CHECK_HIP(hipFree(p));
+            });
+            std::string name = "hipMalloc+hipFree[" + std::to_string(bytes) + "B]";
+            print_bench_row(name.c_str(), device, s);
+        }
+
+        // Pool path: prime the pool once, then measure steady-state reuse
+        {
+            void* p = nullptr;
+            CHECK_HIP(hipMallocAsync(&p, bytes, stream));
+            CHECK_HIP(hipFreeAsync(p, stream));
+            CHECK_HIP(hipStreamSynchronize(stream));
+
+            BenchStats s = bench_loop([&] {
+                CHECK_HIP(hipMallocAsync(&p, bytes, stream));
+                CHECK_HIP(hipFreeAsync(p, stream));
+            });
+            CHECK_HIP(hipStreamSynchronize(stream));
+            std::string name = "hipMallocAsync+hipFreeAsync[" + std::to_string(bytes) + "B]";
+            print_bench_row(name.c_str(), device, s);
+        }
+    }
+
+    CHECK_HIP(hipStreamDestroy(stream));
+}
+REGISTER_BENCH("--alloc-bench", bench_alloc_latency);
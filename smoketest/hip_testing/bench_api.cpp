@@ -0,0 +1,97 @@
+#include "hip_api_test.h"
+
+// HIP API latency microbenchmark (--bench)
+//
+// Wraps the APIs the functional tests touch once each in timed loops and
+// reports min/median/p99 latency per call in CSV, so an API overhead
+// regression in a new ROCm build shows up in seconds instead of after a
+// multi-hour rccl-tests sweep.
+
+static void bench_api_latency() {
+    int device = 0;
+    CHECK_HIP(hipGetDevice(&device));
+
+    std::cout << "api,device,iters,min_us,median_us,p99_us\n";
+
+    // --- memory_apis path ---
+    {
+        void* p = nullptr;
+        BenchStats s = bench_loop([&] { CHECK_HIP(hipMalloc(&p, 1024)); CHECK_HIP(hipFree(p)); });
+        print_bench_row("hipMalloc+hipFree_1KB", device, s);
+    }
+    {
+        void* p = nullptr;
+        CHECK_HIP(hipMalloc(&p, 1024));
+        BenchStats s = bench_loop([&] { CHECK_HIP(hipMemset(p, 0, 1024)); });
+        print_bench_row("hipMemset_1KB", device, s);
+
+        hipDeviceptr_t base;
+        size_t size;
+        s = bench_loop([&] { CHECK_HIP(hipMemGetAddressRange(&base, &size, (hipDeviceptr_t)p)); });
+        print_bench_row("hipMemGetAddressRange", device, s);
+        CHECK_HIP(hipFree(p));
+    }
+
+    // --- async_and_stream_ops path ---
+    {
+        hipStream_t stream;
+        BenchStats s = bench_loop([&] {
+            CHECK_HIP(hipStreamCreate(&stream));
+            CHECK_HIP(hipStreamDestroy(stream));
+        });
+        print_bench_row("hipStreamCreate+Destroy", device, s);
+    }
+    {
+        hipStream_t stream;
+        CHECK_HIP(hipStreamCreate(&stream));
+        float* d_ptr = nullptr;
+        float h_val = 5.0f;
+        CHECK_HIP(hipMalloc(&d_ptr, sizeof(float)));
+
+        BenchStats s = bench_loop([&] {
+            CHECK_HIP(hipMemcpyAsync(d_ptr, &h_val, sizeof(float),
+                                     hipMemcpyHostToDevice, stream));
+            CHECK_HIP(hipStreamSynchronize(stream));
+        });
+        print_bench_row("hipMemcpyAsync_H2D_4B+sync", device, s);
+
+        hipEvent_t evt;
+        CHECK_HIP(hipEventCreate(&evt));
+        s = bench_loop([&] { CHECK_HIP(hipEventRecord(evt, stream)); });
+        print_bench_row("hipEventRecord", device, s);
+        CHECK_HIP(hipStreamSynchronize(stream));
+
+        s = bench_loop([&] {
+            hipError_t q = hipStreamQuery(stream);
+            if (q != hipSuccess && q != hipErrorNotReady)
+                CHECK_HIP(q);
+        });
+        print_bench_row("hipStreamQuery", device, s);
+
+        CHECK_HIP(hipEventDestroy(evt));
+        CHECK_HIP(hipFree(d_ptr));
+        CHECK_HIP(hipStreamDestroy(stream));
+    }
+
+    // --- pointer_and_events path ---
+    {
+        float* d_ptr = nullptr;
+        CHECK_HIP(hipMalloc(&d_ptr, sizeof(float)));
+        hipPointerAttribute_t memoryType;
+        BenchStats s = bench_loop([&] {
+            CHECK_HIP(hipPointerGetAttribute(&memoryType,
+                                             HIP_POINTER_ATTRIBUTE_MEMORY_TYPE,
+                                             (void*)d_ptr));
+        });
+        print_bench_row("hipPointerGetAttribute", device, s);
+        CHECK_HIP(hipFree(d_ptr));
+
+        hipEvent_t evt;
+        s = bench_loop([&] {
+            CHECK_HIP(hipEventCreateWithFlags(&evt, hipEventDefault));
+            CHECK_HIP(hipEventDestroy(evt));
+        });
+        print_bench_row("hipEventCreate+Destroy", device, s);
+    }
+}
+REGISTER_BENCH("--bench", bench_api_latency);
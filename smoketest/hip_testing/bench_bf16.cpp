@@ -0,0 +1,95 @@
+#include "hip_api_test.h"
+
+#include <hip/hip_bfloat16.h>
+
+// bf16 conversion throughput benchmark (--bf16-bench)
+//
+// Grows the single-element bf16 test kernel into a real throughput check:
+// four-way unrolled bf16<->float conversion over a large buffer, swept
+// across block sizes, reporting effective GB/s per device. A one-minute
+// check that the compiler/hardware conversion path has not regressed
+// before committing to a long RCCL sweep.
+
+__global__ void bf16_to_float_bulk(const hip_bfloat16* in, float* out, size_t n) {
+    size_t i = ((size_t)blockIdx.x * blockDim.x + threadIdx.x) * 4;
+    size_t stride = (size_t)gridDim.x * blockDim.x * 4;
+    for (; i + 3 < n; i += stride) {
+        out[i + 0] = static_cast<float>(in[i + 0]);
+        out[i + 1] = static_cast<float>(in[i + 1]);
+        out[i + 2] = static_cast<float>(in[i + 2]);
+        out[i + 3] = static_cast<float>(in[i + 3]);
+    }
+}
+
+__global__ void float_to_bf16_bulk(const float* in, hip_bfloat16* out, size_t n) {
+    size_t i = ((size_t)blockIdx.x * blockDim.x + threadIdx.x) * 4;
+    size_t stride = (size_t)gridDim.x * blockDim.x * 4;
+    for (; i + 3 < n; i += stride) {
+        out[i + 0] = hip_bfloat16(in[i + 0]);
+        out[i + 1] = hip_bfloat16(in[i + 1]);
+        out[i + 2] = hip_bfloat16(in[i + 2]);
+        out[i + 3] = hip_bfloat16(in[i + 3]);
+    }
+}
+
+static void bench_bf16_throughput() {
+    int deviceCount = 0;
+    CHECK_HIP(hipGetDeviceCount(&deviceCount));
+
+    std::cout << "direction,device,block_size,elements,GBps\n";
+
+    for (int dev = 0; dev < deviceCount; dev++) {
+        CHECK_HIP(hipSetDevice(dev));
+
+        size_t freeMem = 0, totalMem = 0;
+        CHECK_HIP(hipMemGetInfo(&freeMem, &totalMem));
+
+        // bf16 + float buffer = 6 bytes/element; use at most a quarter of free VRAM
+        size_t n = freeMem / 4 / 6;
+        n = std::min(n, (size_t)1 << 30);
+        n &= ~(size_t)3;
+
+        hip_bfloat16* d_bf = nullptr;
+        float* d_f = nullptr;
+        CHECK_HIP(hipMalloc(&d_bf, n * sizeof(hip_bfloat16)));
+        CHECK_HIP(hipMalloc(&d_f, n * sizeof(float)));
+        CHECK_HIP(hipMemset(d_bf, 0, n * sizeof(hip_bfloat16)));
+        CHECK_HIP(hipMemset(d_f, 0, n * sizeof(float)));
+
+        const int blockSizes[] = {64, 128, 256, 512, 1024};
+        const int iters = 10;
+        const double bytesMoved = (double)n * (sizeof(hip_bfloat16) + sizeof(float));
+
+        for (int block : blockSizes) {
+            int grid = (int)std::min((n / 4 + block - 1) / (size_t)block, (size_t)65536);
+
+            // bf16 -> float
+            bf16_to_float_bulk<<<grid, block>>>(d_bf, d_f, n);  // warm up
+            CHECK_HIP(hipDeviceSynchronize());
+            auto t0 = std::chrono::steady_clock::now();
+            for (int i = 0; i < iters; i++)
+                bf16_to_float_bulk<<<grid, block>>>(d_bf, d_f, n);
+            CHECK_HIP(hipDeviceSynchronize());
+            auto t1 = std::chrono::steady_clock::now();
+            double sec = std::chrono::duration<double>(t1 - t0).count() / iters;
+            std::cout << "bf16_to_float," << dev << "," << block << "," << n
+                      << "," << bytesMoved / sec / 1e9 << "\n";
+
+            // float -> bf16
+            float_to_bf16_bulk<<<grid, block>>>(d_f, d_bf, n);  // warm up
+            CHECK_HIP(hipDeviceSynchronize());
+            t0 = std::chrono::steady_clock::now();
+            for (int i = 0; i < iters; i++)
+                float_to_bf16_bulk<<<grid, block>>>(d_f, d_bf, n);
+            CHECK_HIP(hipDeviceSynchronize());
+            t1 = std::chrono::steady_clock::now();
+            sec = std::chrono::duration<double>(t1 - t0).count() / iters;
+            std::cout << "float_to_bf16," << dev << "," << block << "," << n
+                      << "," << bytesMoved / sec / 1e9 << "\n";
+        }
+
+        CHECK_HIP(hipFree(d_bf));
+        CHECK_HIP(hipFree(d_f));
+    }
+}
+REGISTER_BENCH("--bf16-bench", bench_bf16_throughput);
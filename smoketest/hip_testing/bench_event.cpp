@@ -0,0 +1,72 @@
+#include "hip_api_test.h"
+
+// Event timing overhead benchmark (--event-bench)
+//
+// Quantifies the cost of hipEventRecord / hipEventQuery /
+// hipEventSynchronize / hipEventElapsedTime for each event flag combination
+// the pointer/events test creates (plus hipEventDisableTiming), so we know
+// the observer overhead of our own event-pair instrumentation on every
+// stack we deploy.
+
+static void bench_event_overhead() {
+    int device = 0;
+    CHECK_HIP(hipGetDevice(&device));
+
+    hipStream_t stream;
+    CHECK_HIP(hipStreamCreate(&stream));
+
+    struct EventFlagCombo {
+        const char* name;
+        unsigned flags;
+    };
+    const EventFlagCombo combos[] = {
+        {"default",       hipEventDefault},
+        {"blocking_sync", hipEventBlockingSync},
+        {"disable_timing", hipEventDisableTiming},
+        {"blocking_sync|disable_timing", hipEventBlockingSync | hipEventDisableTiming},
+    };
+
+    // The flag combo is folded into the row name so the shared helper can
+    // emit both the CSV line and the structured-sink record
+    std::cout << "api,device,iters,min_us,median_us,p99_us\n";
+
+    for (const auto& combo : combos) {
+        std::string suffix = "[" + std::string(combo.name) + "]";
+        hipEvent_t start, stop;
+        CHECK_HIP(hipEventCreateWithFlags(&start, combo.flags));
+        CHECK_HIP(hipEventCreateWithFlags(&stop, combo.flags));
+
+        BenchStats s = bench_loop([&] { CHECK_HIP(hipEventRecord(stop, stream)); });
+        CHECK_HIP(hipStreamSynchronize(stream));
+        print_bench_row(("hipEventRecord" + suffix).c_str(), device, s);
+
+        s = bench_loop([&] {
+            hipError_t q = hipEventQuery(stop);
+            if (q != hipSuccess && q != hipErrorNotReady)
+                CHECK_HIP(q);
+        });
+        print_bench_row(("hipEventQuery" + suffix).c_str(), device, s);
+
+        s = bench_loop([&] {
+            CHECK_HIP(hipEventRecord(stop, stream));
+            CHECK_HIP(hipEventSynchronize(stop));
+        });
+        print_bench_row(("hipEventRecord+Synchronize" + suffix).c_str(), device, s);
+
+        // Elapsed time needs timing enabled on both events
+        if (!(combo.flags & hipEventDisableTiming)) {
+            CHECK_HIP(hipEventRecord(start, stream));
+            CHECK_HIP(hipEventRecord(stop, stream));
+            CHECK_HIP(hipEventSynchronize(stop));
+            float ms = 0.0f;
+            s = bench_loop([&] { CHECK_HIP(hipEventElapsedTime(&ms, start, stop)); });
+            print_bench_row(("hipEventElapsedTime" + suffix).c_str(), device, s);
+        }
+
+        CHECK_HIP(hipEventDestroy(start));
+        CHECK_HIP(hipEventDestroy(stop));
+    }
+
+    CHECK_HIP(hipStreamDestroy(stream));
+}
+REGISTER_BENCH("--event-bench", bench_event_overhead);
@@ -0,0 +1,82 @@
+#include "hip_api_test.h"
+
+// Graph replay throughput benchmark (--graph-bench)
+//
+// Captures chains of memset/kernel work into graphs of growing node count
+// (the same capture path the graphs test exercises once), replays each
+// instantiated graph tens of thousands of times, and reports per-launch
+// overhead against the equivalent eager stream submission. Quantifies
+// hipGraphLaunch dispatch cost per ROCm build.
+
+static constexpr int kGraphReplayIters = 20000;
+
+static void bench_graph_replay() {
+    int device = 0;
+    CHECK_HIP(hipGetDevice(&device));
+
+    hipStream_t stream;
+    CHECK_HIP(hipStreamCreate(&stream));
+
+    const int nodeCounts[] = {1, 4, 16, 64};
+    const size_t bufBytes = 1024;
+
+    std::cout << "mode,device,nodes,iters,per_launch_us\n";
+
+    for (int nodes : nodeCounts) {
+        // One small buffer per node so the chain is real work, not aliasing
+        std::vector<void*> buffers(nodes, nullptr);
+        for (int i = 0; i < nodes; i++)
+            CHECK_HIP(hipMalloc(&buffers[i], bufBytes));
+
+        float* d_val = nullptr;
+        CHECK_HIP(hipMalloc(&d_val, sizeof(float)));
+
+        // Capture a chain of memsets plus one kernel into a graph
+        hipGraph_t graph;
+        hipGraphExec_t instance;
+        CHECK_HIP(hipStreamBeginCapture(stream, hipStreamCaptureModeGlobal));
+        for (int i = 0; i < nodes; i++)
+            CHECK_HIP(hipMemsetAsync(buffers[i], 1, bufBytes, stream));
+        hipLaunchKernelGGL(simple_kernel, dim3(1), dim3(1), 0, stream, d_val);
+        CHECK_HIP(hipStreamEndCapture(stream, &graph));
+        CHECK_HIP(hipGraphInstantiate(&instance, graph, nullptr, nullptr, 0));
+
+        // Graph replay: launch many times, sync once at the end
+        CHECK_HIP(hipGraphLaunch(instance, stream));   // warm up
+        CHECK_HIP(hipStreamSynchronize(stream));
+        auto t0 = std::chrono::steady_clock::now();
+        for (int i = 0; i < kGraphReplayIters; i++)
+            CHECK_HIP(hipGraphLaunch(instance, stream));
+        CHECK_HIP(hipStreamSynchronize(stream));
+        auto t1 = std::chrono::steady_clock::now();
+        double graphUs = std::chrono::duration<double, std::micro>(t1 - t0).count()
+                         / kGraphReplayIters;
+        std::cout << "graph," << device << "," << nodes << ","
+                  << kGraphReplayIters << "," << graphUs << "\n";
+
+        // Eager path: submit the same chain directly, as the async/stream
+        // test does
+        const int eagerIters = kGraphReplayIters / 10;
+        t0 = std::chrono::steady_clock::now();
+        for (int i = 0; i < eagerIters; i++) {
+            for (int n = 0; n < nodes; n++)
+                CHECK_HIP(hipMemsetAsync(buffers[n], 1, bufBytes, stream));
+            hipLaunchKernelGGL(simple_kernel, dim3(1), dim3(1), 0, stream, d_val);
+        }
+        CHECK_HIP(hipStreamSynchronize(stream));
+        t1 = std::chrono::steady_clock::now();
+        double eagerUs = std::chrono::duration<double, std::micro>(t1 - t0).count()
+                         / eagerIters;
+        std::cout << "eager," << device << "," << nodes << ","
+                  << eagerIters << "," << eagerUs << "\n";
+
+        CHECK_HIP(hipGraphExecDestroy(instance));
+        CHECK_HIP(hipGraphDestroy(graph));
+        CHECK_HIP(hipFree(d_val));
+        for (int i = 0; i < nodes; i++)
+            CHECK_HIP(hipFree(buffers[i]));
+    }
+
+    CHECK_HIP(hipStreamDestroy(stream));
+}
+REGISTER_BENCH("--graph-bench", bench_graph_replay);
@@ -0,0 +1,102 @@
+#include "hip_api_test.h"
+
+// Host-transfer bandwidth sweep (--hostmem-bench)
+//
+// Sweeps H2D/D2H copies from 4KB up to 4GB (capped by free VRAM) across
+// pageable malloc, hipHostMalloc-pinned, hipHostRegister-ed and
+// hipMallocManaged buffers, reporting GB/s per class. Verifies the
+// pinned-path DMA performance before a new stack is deployed.
+
+static double time_transfer(void* dst, const void* src, size_t bytes,
+                            hipMemcpyKind kind, hipStream_t stream, int iters) {
+    CHECK_HIP(hipMemcpyAsync(dst, src, bytes, kind, stream));  // warm up
+    CHECK_HIP(hipStreamSynchronize(stream));
+    auto t0 = std::chrono::steady_clock::now();
+    for (int i = 0; i < iters; i++)
+        CHECK_HIP(hipMemcpyAsync(dst, src, bytes, kind, stream));
+    CHECK_HIP(hipStreamSynchronize(stream));
+    auto t1 = std::chrono::steady_clock::now();
+    return std::chrono::duration<double>(t1 - t0).count() / iters;
+}
+
+static void bench_host_transfers() {
+    int device = 0;
+    CHECK_HIP(hipGetDevice(&device));
+
+    size_t freeMem = 0, totalMem = 0;
+    CHECK_HIP(hipMemGetInfo(&freeMem, &totalMem));
+
+    const size_t minBytes = 4 * 1024;
+    size_t maxBytes = (size_t)4 * 1024 * 1024 * 1024;
+    // Leave headroom: the device buffer plus a managed buffer both count
+    while (maxBytes * 3 > freeMem && maxBytes > minBytes)
+        maxBytes /= 2;
+
+    hipStream_t stream;
+    CHECK_HIP(hipStreamCreate(&stream));
+
+    void* d_buf = nullptr;
+    CHECK_HIP(hipMalloc(&d_buf, maxBytes));
+
+    std::cout << "class,device,bytes,h2d_GBps,d2h_GBps\n";
+
+    for (size_t bytes = minBytes; bytes <= maxBytes; bytes *= 4) {
+        // Fewer iterations for the large sizes, enough for the small ones
+        int iters = bytes >= (256u * 1024 * 1024) ? 5 : 50;
+
+        // Pageable malloc
+        {
+            void* h_buf = std::malloc(bytes);
+            if (!h_buf)
+                throw std::runtime_error("malloc failed in bench_host_transfers");
+            std::memset(h_buf, 0, bytes);
+            double h2d = time_transfer(d_buf, h_buf, bytes, hipMemcpyHostToDevice, stream, iters);
+            double d2h = time_transfer(h_buf, d_buf, bytes, hipMemcpyDeviceToHost, stream, iters);
+            std::cout << "pageable," << device << "," << bytes << ","
+                      << bytes / h2d / 1e9 << "," << bytes / d2h / 1e9 << "\n";
+            std::free(h_buf);
+        }
+
+        // hipHostMalloc pinned
+        {
+            void* h_buf = nullptr;
+            CHECK_HIP(hipHostMalloc(&h_buf, bytes));
+            double h2d = time_transfer(d_buf, h_buf, bytes, hipMemcpyHostToDevice, stream, iters);
+            double d2h = time_transfer(h_buf, d_buf, bytes, hipMemcpyDeviceToHost, stream, iters);
+            std::cout << "pinned," << device << "," << bytes << ","
+                      << bytes / h2d / 1e9 << "," << bytes / d2h / 1e9 << "\n";
+            CHECK_HIP(hipHostFree(h_buf));
+        }
+
+        // hipHostRegister-ed pageable memory
+        {
+            void* h_buf = std::malloc(bytes);
+            if (!h_buf)
+                throw std::runtime_error("malloc failed in bench_host_transfers");
+            std::memset(h_buf, 0, bytes);
+            CHECK_HIP(hipHostRegister(h_buf, bytes, hipHostRegisterDefault));
+            double h2d = time_transfer(d_buf, h_buf, bytes, hipMemcpyHostToDevice, stream, iters);
+            double d2h = time_transfer(h_buf, d_buf, bytes, hipMemcpyDeviceToHost, stream, iters);
+            std::cout << "registered," << device << "," << bytes << ","
+                      << bytes / h2d / 1e9 << "," << bytes / d2h / 1e9 << "\n";
+            CHECK_HIP(hipHostUnregister(h_buf));
+            std::free(h_buf);
+        }
+
+        // hipMallocManaged
+        {
+            void* m_buf = nullptr;
+            CHECK_HIP(hipMallocManaged(&m_buf, bytes));
+            std::memset(m_buf, 0, bytes);
+            double h2d = time_transfer(d_buf, m_buf, bytes, hipMemcpyHostToDevice, stream, iters);
+            double d2h = time_transfer(m_buf, d_buf, bytes, hipMemcpyDeviceToHost, stream, iters);
+            std::cout << "managed," << device << "," << bytes << ","
+                      << bytes / h2d / 1e9 << "," << bytes / d2h / 1e9 << "\n";
+            CHECK_HIP(hipFree(m_buf));
+        }
+    }
+
+    CHECK_HIP(hipFree(d_buf));
+    CHECK_HIP(hipStreamDestroy(stream));
+}
+REGISTER_BENCH("--hostmem-bench", bench_host_transfers);
@@ -0,0 +1,82 @@
+#include "hip_api_test.h"
+
+// Runtime and device-property startup cost profiler (--startup)
+//
+// Measures time-to-first-API (implicit HIP runtime initialization) and the
+// per-call cost of the device/property queries the device-info test makes,
+// across all devices. This is the fixed per-process tax every short-lived
+// tool pays — hundreds of times per sweeptest.sh run — broken down so it
+// can be tracked per ROCm build.
+//
+// Run --startup as the first (or only) mode of the process; a HIP call made
+// earlier would absorb the runtime initialization this measures.
+
+static void bench_startup_cost() {
+    std::cout << "phase,device,calls,total_us,per_call_us\n";
+
+    // First HIP call of the process: pays for runtime init
+    int deviceCount = 0;
+    auto t0 = std::chrono::steady_clock::now();
+    CHECK_HIP(hipGetDeviceCount(&deviceCount));
+    auto t1 = std::chrono::steady_clock::now();
+    double us = std::chrono::duration<double, std::micro>(t1 - t0).count();
+    std::cout << "time_to_first_api,-1,1," << us << "," << us << "\n";
+
+    // Warm per-call cost of the same query
+    const int iters = 1000;
+    t0 = std::chrono::steady_clock::now();
+    for (int i = 0; i < iters; i++)
+        CHECK_HIP(hipGetDeviceCount(&deviceCount));
+    t1 = std::chrono::steady_clock::now();
+    us = std::chrono::duration<double, std::micro>(t1 - t0).count();
+    std::cout << "hipGetDeviceCount,-1," << iters << "," << us << ","
+              << us / iters << "\n";
+
+    // Per-device property queries, first call (cold) then warm average
+    for (int dev = 0; dev < deviceCount; dev++) {
+        hipDeviceProp_t props;
+        t0 = std::chrono::steady_clock::now();
+        CHECK_HIP(hipGetDeviceProperties(&props, dev));
+        t1 = std::chrono::steady_clock::now();
+        us = std::chrono::duration<double, std::micro>(t1 - t0).count();
+        std::cout << "hipGetDeviceProperties_cold," << dev << ",1," << us
+                  << "," << us << "\n";
+
+        t0 = std::chrono::steady_clock::now();
+        for (int i = 0; i < iters; i++)
+            CHECK_HIP(hipGetDeviceProperties(&props, dev));
+        t1 = std::chrono::steady_clock::now();
+        us = std::chrono::duration<double, std::micro>(t1 - t0).count();
+        std::cout << "hipGetDeviceProperties," << dev << "," << iters << ","
+                  << us << "," << us / iters << "\n";
+
+        int busId = -1;
+        t0 = std::chrono::steady_clock::now();
+        for (int i = 0; i < iters; i++)
+            CHECK_HIP(hipDeviceGetAttribute(&busId, hipDeviceAttributePciBusId, dev));
+        t1 = std::chrono::steady_clock::now();
+        us = std::chrono::duration<double, std::micro>(t1 - t0).count();
+        std::cout << "hipDeviceGetAttribute," << dev << "," << iters << ","
+                  << us << "," << us / iters << "\n";
+
+        char pciBusIdStr[20];
+        t0 = std::chrono::steady_clock::now();
+        for (int i = 0; i < iters; i++)
+            CHECK_HIP(hipDeviceGetPCIBusId(pciBusIdStr, 20, dev));
+        t1 = std::chrono::steady_clock::now();
+        us = std::chrono::duration<double, std::micro>(t1 - t0).count();
+        std::cout << "hipDeviceGetPCIBusId," << dev << "," << iters << ","
+                  << us << "," << us / iters << "\n";
+    }
+
+    // First context touch per device (lazy per-device initialization)
+    for (int dev = 0; dev < deviceCount; dev++) {
+        CHECK_HIP(hipSetDevice(dev));
+        t0 = std::chrono::steady_clock::now();
+        CHECK_HIP(hipFree(nullptr));   // forces context creation
+        t1 = std::chrono::steady_clock::now();
+        us = std::chrono::duration<double, std::micro>(t1 - t0).count();
+        std::cout << "first_context_touch," << dev << ",1," << us << "," << us << "\n";
+    }
+}
+REGISTER_BENCH("--startup", bench_startup_cost);
@@ -0,0 +1,207 @@
+#ifndef HIP_API_TEST_H
+#define HIP_API_TEST_H
+
+// Shared infrastructure for the HIP smoke/benchmark suite. Each stage lives
+// in its own translation unit and self-registers here, so `make -j` builds
+// them in parallel and an incremental rebuild touches one object.
+
+#include <hip/hip_runtime.h>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include <cstring>
+#include <cstdlib>
+#include <cstdio>
+#include <chrono>
+#include <mutex>
+#include <algorithm>
+
+// Throws instead of exiting so a failure on one device does not kill the
+// suites running concurrently on the other devices.
+#define CHECK_HIP(cmd)                                                     \
+  do {                                                                      \
+    hipError_t e = cmd;                                                     \
+    if (e != hipSuccess) {                                                  \
+      std::ostringstream oss;                                               \
+      oss << "HIP error: " << hipGetErrorString(e)                          \
+          << " at " << __FILE__ << ":" << __LINE__;                         \
+      throw std::runtime_error(oss.str());                                  \
+    }                                                                       \
+  } while (0)
+
+// ================================
+// Structured results sink (--format=json|csv [--output=FILE])
+// ================================
+// Buffered machine-readable results: every test and benchmark stage reports
+// name, device, timing and status here instead of only through iostream
+// prose. Records accumulate in memory and are written in one shot at the
+// end, so emission never interleaves with timing regions.
+
+enum class ResultFormat { None, Csv, Jsonl };
+
+class ResultSink {
+public:
+    void open(ResultFormat fmt, const std::string& path) {
+        fmt_ = fmt;
+        path_ = path;
+        if (fmt_ == ResultFormat::Csv)
+            buf_ = "name,device,seconds,status,detail\n";
+    }
+
+    bool enabled() const { return fmt_ != ResultFormat::None; }
+
+    void record(const std::string& name, int device, double seconds,
+                const char* status, const std::string& detail = "") {
+        if (!enabled())
+            return;
+        std::lock_guard<std::mutex> lock(mtx_);
+        std::ostringstream oss;
+        if (fmt_ == ResultFormat::Csv) {
+            oss << name << "," << device << "," << seconds << "," << status
+                << "," << detail << "\n";
+        } else {
+            oss << "{\"name\":\"" << escape(name) << "\",\"device\":" << device
+                << ",\"seconds\":" << seconds << ",\"status\":\"" << status
+                << "\",\"detail\":\"" << escape(detail) << "\"}\n";
+        }
+        buf_ += oss.str();
+    }
+
+    void flush() {
+        if (!enabled() || buf_.empty())
+            return;
+        std::lock_guard<std::mutex> lock(mtx_);
+        if (path_.empty()) {
+            std::fwrite(buf_.data(), 1, buf_.size(), stdout);
+        } else {
+            std::FILE* f = std::fopen(path_.c_str(), "w");
+            if (!f) {
+                std::cerr << "Cannot open results file: " << path_ << std::endl;
+                return;
+            }
+            std::fwrite(buf_.data(), 1, buf_.size(), f);
+            std::fclose(f);
+        }
+        buf_.clear();
+    }
+
+private:
+    static std::string escape(const std::string& s) {
+        std::string out;
+        out.reserve(s.size());
+        for (char c : s) {
+            if (c == '"' || c == '\\')
+                out += '\\';
+            if (c == '\n') {
+                out += "\\n";
+                continue;
+            }
+            out += c;
+        }
+        return out;
+    }
+
+    std::mutex mtx_;
+    std::string buf_;
+    ResultFormat fmt_ = ResultFormat::None;
+    std::string path_;
+};
+
+extern ResultSink g_results;
+
+// ================================
+// Stage registries
+// ================================
+// Per-device functional tests and flag-selected benchmark modes register
+// themselves at static-initialization time from their own translation unit.
+
+struct TestCase {
+    const char* name;
+    void (*fn)();
+    bool stressSafe;   // false: skipped by --stress (e.g. global-mode capture)
+};
+
+struct BenchMode {
+    const char* flag;
+    void (*fn)();
+};
+
+std::vector<TestCase>& test_registry();
+std::vector<BenchMode>& bench_registry();
+
+struct TestRegistrar {
+    TestRegistrar(const char* name, void (*fn)(), bool stressSafe = true);
+};
+
+struct BenchRegistrar {
+    BenchRegistrar(const char* flag, void (*fn)());
+};
+
+#define REGISTER_TEST(name, fn) \
+    static TestRegistrar testreg_##fn(name, fn)
+#define REGISTER_TEST_NO_STRESS(name, fn) \
+    static TestRegistrar testreg_##fn(name, fn, false)
+#define REGISTER_BENCH(flag, fn) \
+    static BenchRegistrar benchreg_##fn(flag, fn)
+
+// ================================
+// Benchmark timing helpers
+// ================================
+
+inline constexpr int kBenchWarmup = 200;
+inline constexpr int kBenchIters  = 5000;
+
+struct BenchStats {
+    double minUs;
+    double medianUs;
+    double p99Us;
+};
+
+inline BenchStats summarize_us(std::vector<double>& samples) {
+    std::sort(samples.begin(), samples.end());
+    BenchStats s;
+    s.minUs    = samples.front();
+    s.medianUs = samples[samples.size() / 2];
+    s.p99Us    = samples[(samples.size() * 99) / 100];
+    return s;
+}
+
+// Times one call of `body` per iteration; warm-up iterations are discarded.
+template <typename F>
+BenchStats bench_loop(F&& body, int iters = kBenchIters) {
+    std::vector<double> samples;
+    samples.reserve(iters);
+    for (int i = 0; i < kBenchWarmup + iters; i++) {
+        auto t0 = std::chrono::steady_clock::now();
+        body();
+        auto t1 = std::chrono::steady_clock::now();
+        if (i >= kBenchWarmup)
+            samples.push_back(std::chrono::duration<double, std::micro>(t1 - t0).count());
+    }
+    return summarize_us(samples);
+}
+
+inline void print_bench_row(const char* api, int device, const BenchStats& s) {
+    std::cout << api << "," << device << "," << kBenchIters << ","
+              << s.minUs << "," << s.medianUs << "," << s.p99Us << "\n";
+    std::ostringstream detail;
+    detail << "min_us=" << s.minUs << " median_us=" << s.medianUs
+           << " p99_us=" << s.p99Us;
+    g_results.record(api, device, s.medianUs * 1e-6, "pass", detail.str());
+}
+
+// Shared kernels (defined in suite_tests.cpp / bench_launch.cpp)
+__global__ void simple_kernel(float* data);
+__global__ void noop_kernel();
+
+// Node-wide device/runtime info stage, run once by main before the
+// per-device suite fans out
+void test_device_info();
+
+// --stress duration, settable via --stress=<seconds>
+extern int g_stressSeconds;
+void run_stress_mode();
+
+#endif  // HIP_API_TEST_H
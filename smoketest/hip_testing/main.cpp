@@ -0,0 +1,246 @@
+#include "hip_api_test.h"
+
+#include <condition_variable>
+#include <functional>
+#include <queue>
+#include <thread>
+
+// Multi-GPU parallel execution engine
+//
+// Runs the registered per-device test suite concurrently on every visible
+// GPU through a small thread pool, so a node health check takes roughly the
+// single-device time regardless of GPU count. Benchmark modes registered by
+// the bench_*.cpp stages are selected by flag.
+
+struct DeviceResult {
+    int device = -1;
+    bool passed = false;
+    double wallTimeSec = 0.0;
+    std::string failure;   // "<test>: <error>" when passed == false
+};
+
+class ThreadPool {
+public:
+    explicit ThreadPool(size_t numThreads) {
+        for (size_t i = 0; i < numThreads; i++) {
+            workers_.emplace_back([this] {
+                for (;;) {
+                    std::function<void()> task;
+                    {
+                        std::unique_lock<std::mutex> lock(mtx_);
+                        cv_.wait(lock, [this] { return stop_ || !tasks_.empty(); });
+                        if (stop_ && tasks_.empty())
+                            return;
+                        task = std::move(tasks_.front());
+                        tasks_.pop();
+                    }
+                    task();
+                }
+            });
+        }
+    }
+
+    void enqueue(std::function<void()> task) {
+        {
+            std::lock_guard<std::mutex> lock(mtx_);
+            tasks_.push(std::move(task));
+        }
+        cv_.notify_one();
+    }
+
+    ~ThreadPool() {
+        {
+            std::lock_guard<std::mutex> lock(mtx_);
+            stop_ = true;
+        }
+        cv_.notify_all();
+        for (auto& w : workers_)
+            w.join();
+    }
+
+private:
+    std::vector<std::thread> workers_;
+    std::queue<std::function<void()>> tasks_;
+    std::mutex mtx_;
+    std::condition_variable cv_;
+    bool stop_ = false;
+};
+
+static DeviceResult run_suite_on_device(int dev) {
+    DeviceResult result;
+    result.device = dev;
+
+    auto t0 = std::chrono::steady_clock::now();
+    try {
+        CHECK_HIP(hipSetDevice(dev));
+        for (const auto& test : test_registry()) {
+            auto testT0 = std::chrono::steady_clock::now();
+            try {
+                test.fn();
+            } catch (const std::exception& e) {
+                auto testT1 = std::chrono::steady_clock::now();
+                g_results.record(test.name, dev,
+                                 std::chrono::duration<double>(testT1 - testT0).count(),
+                                 "fail", e.what());
+                result.failure = std::string(test.name) + ": " + e.what();
+                throw;
+            }
+            auto testT1 = std::chrono::steady_clock::now();
+            g_results.record(test.name, dev,
+                             std::chrono::duration<double>(testT1 - testT0).count(),
+                             "pass");
+        }
+        result.passed = true;
+    } catch (const std::exception& e) {
+        if (result.failure.empty())
+            result.failure = e.what();
+    }
+    auto t1 = std::chrono::steady_clock::now();
+    result.wallTimeSec = std::chrono::duration<double>(t1 - t0).count();
+    return result;
+}
+
+static const BenchMode kStressMode = {"--stress", run_stress_mode};
+
+int main(int argc, char** argv) {
+    std::vector<const BenchMode*> selected;
+    ResultFormat format = ResultFormat::None;
+    std::string outputPath;
+    for (int i = 1; i < argc; i++) {
+        // --stress takes an optional duration: --stress or --stress=120
+        if (std::strncmp(argv[i], "--stress", 8) == 0) {
+            if (argv[i][8] == '=')
+                g_stressSeconds = std::atoi(argv[i] + 9);
+            if (argv[i][8] == '\0' || (argv[i][8] == '=' && g_stressSeconds > 0)) {
+                selected.push_back(&kStressMode);
+                continue;
+            }
+        }
+        if (std::strncmp(argv[i], "--format=", 9) == 0) {
+            const char* fmt = argv[i] + 9;
+            if (std::strcmp(fmt, "json") == 0) {
+                format = ResultFormat::Jsonl;
+            } else if (std::strcmp(fmt, "csv") == 0) {
+                format = ResultFormat::Csv;
+            } else {
+                std::cerr << "Unknown format: " << fmt << " (json|csv)\n";
+                return EXIT_FAILURE;
+            }
+            continue;
+        }
+        if (std::strncmp(argv[i], "--output=", 9) == 0) {
+            outputPath = argv[i] + 9;
+            continue;
+        }
+        const BenchMode* match = nullptr;
+        for (const auto& mode : bench_registry()) {
+            if (std::strcmp(argv[i], mode.flag) == 0) {
+                match = &mode;
+                break;
+            }
+        }
+        if (!match) {
+            std::cerr << "Usage: " << argv[0];
+            for (const auto& mode : bench_registry())
+                std::cerr << " [" << mode.flag << "]";
+            std::cerr << " [--stress[=seconds]]"
+                      << " [--format=json|csv] [--output=FILE]\n";
+            return EXIT_FAILURE;
+        }
+        selected.push_back(match);
+    }
+
+    g_results.open(format, outputPath);
+
+    if (!selected.empty()) {
+        int rc = 0;
+        for (const BenchMode* mode : selected) {
+            auto t0 = std::chrono::steady_clock::now();
+            try {
+                mode->fn();
+                auto t1 = std::chrono::steady_clock::now();
+                g_results.record(mode->flag + 2, 0,
+                                 std::chrono::duration<double>(t1 - t0).count(),
+                                 "pass");
+            } catch (const std::exception& e) {
+                auto t1 = std::chrono::steady_clock::now();
+                g_results.record(mode->flag + 2, 0,
+                                 std::chrono::duration<double>(t1 - t0).count(),
+                                 "fail", e.what());
+                std::cerr << e.what() << std::endl;
+                rc = EXIT_FAILURE;
+                break;
+            }
+        }
+        g_results.flush();
+        (void)hipDeviceReset();
+        return rc;
+    }
+
+    std::cout << "--- Starting HIP API Functional Test Suite ---\n";
+
+    std::cout << "\n[1] Device & Runtime Info...\n";
+    try {
+        test_device_info();
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    int deviceCount = 0;
+    try {
+        CHECK_HIP(hipGetDeviceCount(&deviceCount));
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    std::cout << "\n[2] Running per-device suite on " << deviceCount
+              << " device(s) in parallel...\n";
+
+    std::vector<DeviceResult> results(deviceCount);
+    {
+        ThreadPool pool(deviceCount);
+        std::mutex doneMtx;
+        std::condition_variable doneCv;
+        int remaining = deviceCount;
+
+        for (int dev = 0; dev < deviceCount; dev++) {
+            pool.enqueue([dev, &results, &doneMtx, &doneCv, &remaining] {
+                results[dev] = run_suite_on_device(dev);
+                {
+                    std::lock_guard<std::mutex> lock(doneMtx);
+                    remaining--;
+                }
+                doneCv.notify_one();
+            });
+        }
+
+        std::unique_lock<std::mutex> lock(doneMtx);
+        doneCv.wait(lock, [&remaining] { return remaining == 0; });
+    }
+
+    std::cout << "\n--- Per-Device Results ---\n";
+    bool allPassed = true;
+    for (const auto& r : results) {
+        std::cout << "Device " << r.device << ": "
+                  << (r.passed ? "PASS" : "FAIL")
+                  << " (" << r.wallTimeSec << " s)";
+        if (!r.passed) {
+            std::cout << " - " << r.failure;
+            allPassed = false;
+        }
+        std::cout << std::endl;
+    }
+
+    g_results.flush();
+
+    if (!allPassed) {
+        std::cout << "\n--- Test Suite FAILED ---\n";
+        return EXIT_FAILURE;
+    }
+
+    std::cout << "\n--- All Tests Completed Successfully ---\n";
+    (void)hipDeviceReset();
+    return 0;
+}
@@ -0,0 +1,26 @@
+#include "hip_api_test.h"
+
+// Single home for the stage registries and the shared results sink, so
+// static registration from every other translation unit lands in one place.
+
+ResultSink g_results;
+
+int g_stressSeconds = 30;
+
+std::vector<TestCase>& test_registry() {
+    static std::vector<TestCase> tests;
+    return tests;
+}
+
+std::vector<BenchMode>& bench_registry() {
+    static std::vector<BenchMode> modes;
+    return modes;
+}
+
+TestRegistrar::TestRegistrar(const char* name, void (*fn)(), bool stressSafe) {
+    test_registry().push_back({name, fn, stressSafe});
+}
+
+BenchRegistrar::BenchRegistrar(const char* flag, void (*fn)()) {
+    bench_registry().push_back({flag, fn});
+}